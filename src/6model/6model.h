@@ -382,6 +382,14 @@ struct MVMREPROps_Attribute {
     MVMint64 (*is_attribute_initialized) (MVMThreadContext *tc, MVMSTable *st,
         void *data, MVMObject *class_handle, MVMString *name,
         MVMint64 hint);
+
+    /* Gets the address of an attribute, so atomic operations can be done on
+     * it. The kind flag must be MVM_reg_obj or MVM_reg_int64, and says what
+     * the attribute is expected to hold. The address is only valid until the
+     * next GC. */
+    AO_t * (*attribute_as_atomic) (MVMThreadContext *tc, MVMSTable *st,
+        void *data, MVMObject *class_handle, MVMString *name,
+        MVMuint16 kind);
 };
 struct MVMREPROps_Boxing {
     /* Used with boxing. Sets an integer value, for representations that
@@ -498,6 +506,11 @@ struct MVMREPROps_Positional {
 
     /* Gets the STable representing the declared element type. */
     MVMStorageSpec (*get_elem_storage_spec) (MVMThreadContext *tc, MVMSTable *st);
+
+    /* Gets the address of an element, so atomic operations can be done on
+     * it; as for attribute_as_atomic. */
+    AO_t * (*pos_as_atomic) (MVMThreadContext *tc, MVMSTable *st,
+        MVMObject *root, void *data, MVMint64 index, MVMuint16 kind);
 };
 struct MVMREPROps_Associative {
     /* Gets the value at the specified key and places it in the passed
@@ -647,8 +660,6 @@ MVM_PUBLIC MVMObject * MVM_6model_get_how(MVMThreadContext *tc, MVMSTable *st);
 MVM_PUBLIC MVMObject * MVM_6model_get_how_obj(MVMThreadContext *tc, MVMObject *obj);
 void MVM_6model_find_method(MVMThreadContext *tc, MVMObject *obj, MVMString *name, MVMRegister *res);
 MVM_PUBLIC MVMObject * MVM_6model_find_method_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMString *name);
-MVMint32 MVM_6model_find_method_spesh(MVMThreadContext *tc, MVMObject *obj, MVMString *name,
-                                      MVMint32 ss_idx, MVMRegister *res);
 MVMint64 MVM_6model_can_method_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMString *name);
 void MVM_6model_can_method(MVMThreadContext *tc, MVMObject *obj, MVMString *name, MVMRegister *res);
 void MVM_6model_istype(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MVMRegister *res);
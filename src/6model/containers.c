@@ -123,7 +123,10 @@ static const MVMContainerSpec code_pair_spec = {
     code_pair_serialize,
     code_pair_deserialize,
     code_pair_can_store,
-    0
+    0,
+    NULL, /* cas */
+    NULL, /* atomic_load */
+    NULL  /* atomic_store */
 };
 
 static void code_pair_set_container_spec(MVMThreadContext *tc, MVMSTable *st) {
@@ -367,7 +370,10 @@ static const MVMContainerSpec native_ref_spec = {
     native_ref_serialize,
     native_ref_deserialize,
     native_ref_can_store,
-    1
+    1,
+    NULL, /* cas */
+    NULL, /* atomic_load */
+    NULL  /* atomic_store */
 };
 
 static void native_ref_set_container_spec(MVMThreadContext *tc, MVMSTable *st) {
@@ -517,3 +523,54 @@ void MVM_6model_container_assign_s(MVMThreadContext *tc, MVMObject *cont, MVMStr
     else
         MVM_exception_throw_adhoc(tc, "Cannot assign to an immutable value");
 }
+
+/* Atomic container operations. The object ones are delegated to the container
+ * spec; the integer ones are done directly on the memory that a native
+ * integer reference points to. */
+static const MVMContainerSpec * get_atomic_container_spec(MVMThreadContext *tc, MVMObject *cont) {
+    const MVMContainerSpec *cs;
+    if (MVM_is_null(tc, cont) || !IS_CONCRETE(cont))
+        MVM_exception_throw_adhoc(tc, "Cannot perform atomic operations on a type object or null");
+    cs = STABLE(cont)->container_spec;
+    if (!cs || !cs->cas || !cs->atomic_load || !cs->atomic_store)
+        MVM_exception_throw_adhoc(tc,
+            "A %s container does not support atomic operations",
+            STABLE(cont)->debug_name ? STABLE(cont)->debug_name : "<anon>");
+    return cs;
+}
+MVMObject * MVM_6model_container_cas(MVMThreadContext *tc, MVMObject *cont,
+        MVMObject *expected, MVMObject *value) {
+    return get_atomic_container_spec(tc, cont)->cas(tc, cont, expected, value);
+}
+MVMObject * MVM_6model_container_atomic_load(MVMThreadContext *tc, MVMObject *cont) {
+    return get_atomic_container_spec(tc, cont)->atomic_load(tc, cont);
+}
+void MVM_6model_container_atomic_store(MVMThreadContext *tc, MVMObject *cont, MVMObject *value) {
+    get_atomic_container_spec(tc, cont)->atomic_store(tc, cont, value);
+}
+
+static AO_t * native_ref_as_atomic_i(MVMThreadContext *tc, MVMObject *cont) {
+    if (get_container_primitive(tc, cont) != MVM_STORAGE_SPEC_BP_INT)
+        MVM_exception_throw_adhoc(tc,
+            "Can only do integer atomic operations on a container referencing a native integer");
+    return MVM_nativeref_as_atomic_i(tc, cont);
+}
+MVMint64 MVM_6model_container_cas_i(MVMThreadContext *tc, MVMObject *cont,
+        MVMint64 expected, MVMint64 value) {
+    return (MVMint64)MVM_cas(native_ref_as_atomic_i(tc, cont), (AO_t)expected, (AO_t)value);
+}
+MVMint64 MVM_6model_container_atomic_load_i(MVMThreadContext *tc, MVMObject *cont) {
+    return (MVMint64)MVM_load(native_ref_as_atomic_i(tc, cont));
+}
+void MVM_6model_container_atomic_store_i(MVMThreadContext *tc, MVMObject *cont, MVMint64 value) {
+    MVM_store(native_ref_as_atomic_i(tc, cont), (AO_t)value);
+}
+MVMint64 MVM_6model_container_atomic_inc(MVMThreadContext *tc, MVMObject *cont) {
+    return (MVMint64)MVM_incr(native_ref_as_atomic_i(tc, cont));
+}
+MVMint64 MVM_6model_container_atomic_dec(MVMThreadContext *tc, MVMObject *cont) {
+    return (MVMint64)MVM_decr(native_ref_as_atomic_i(tc, cont));
+}
+MVMint64 MVM_6model_container_atomic_add(MVMThreadContext *tc, MVMObject *cont, MVMint64 value) {
+    return (MVMint64)MVM_add(native_ref_as_atomic_i(tc, cont), (AO_t)value);
+}
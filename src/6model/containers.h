@@ -51,6 +51,14 @@ struct MVMContainerSpec {
      * code. This means the VM knows it can safely decontainerize in places
      * it would not be safe or practical to return to the interpreter. */
     MVMuint8 fetch_never_invokes;
+
+    /* Atomic operations on the object held in the container; any of these
+     * may be NULL if the container does not support them. Implementations
+     * must apply the write barrier themselves. cas returns the value that
+     * was seen in the container. */
+    MVMObject * (*cas) (MVMThreadContext *tc, MVMObject *cont, MVMObject *expected, MVMObject *value);
+    MVMObject * (*atomic_load) (MVMThreadContext *tc, MVMObject *cont);
+    void (*atomic_store) (MVMThreadContext *tc, MVMObject *cont, MVMObject *value);
 };
 
 /* A container configurer knows how to attach a certain type of container
@@ -87,3 +95,14 @@ void MVM_6model_container_decont_u(MVMThreadContext *tc, MVMObject *cont, MVMReg
 void MVM_6model_container_assign_i(MVMThreadContext *tc, MVMObject *cont, MVMint64 value);
 void MVM_6model_container_assign_n(MVMThreadContext *tc, MVMObject *cont, MVMnum64 value);
 void MVM_6model_container_assign_s(MVMThreadContext *tc, MVMObject *cont, MVMString *value);
+MVMObject * MVM_6model_container_cas(MVMThreadContext *tc, MVMObject *cont,
+    MVMObject *expected, MVMObject *value);
+MVMObject * MVM_6model_container_atomic_load(MVMThreadContext *tc, MVMObject *cont);
+void MVM_6model_container_atomic_store(MVMThreadContext *tc, MVMObject *cont, MVMObject *value);
+MVMint64 MVM_6model_container_cas_i(MVMThreadContext *tc, MVMObject *cont,
+    MVMint64 expected, MVMint64 value);
+MVMint64 MVM_6model_container_atomic_load_i(MVMThreadContext *tc, MVMObject *cont);
+void MVM_6model_container_atomic_store_i(MVMThreadContext *tc, MVMObject *cont, MVMint64 value);
+MVMint64 MVM_6model_container_atomic_inc(MVMThreadContext *tc, MVMObject *cont);
+MVMint64 MVM_6model_container_atomic_dec(MVMThreadContext *tc, MVMObject *cont);
+MVMint64 MVM_6model_container_atomic_add(MVMThreadContext *tc, MVMObject *cont, MVMint64 value);
@@ -665,6 +665,81 @@ MVM_PUBLIC MVMint64 MVM_repr_attribute_inited(MVMThreadContext *tc, MVMObject *o
         type, name, MVM_NO_HINT);
 }
 
+/* Gets the address of an attribute or element for atomic operations; see
+ * attribute_as_atomic in 6model.h. */
+MVM_PUBLIC AO_t * MVM_repr_attribute_as_atomic(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                               MVMString *name, MVMuint16 kind) {
+    if (!IS_CONCRETE(obj))
+        MVM_exception_throw_adhoc(tc, "Cannot look up attributes in a %s type object", STABLE(obj)->debug_name);
+    return REPR(obj)->attr_funcs.attribute_as_atomic(tc, STABLE(obj), OBJECT_BODY(obj),
+        type, name, kind);
+}
+MVM_PUBLIC AO_t * MVM_repr_pos_as_atomic(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx, MVMuint16 kind) {
+    if (!IS_CONCRETE(obj))
+        MVM_exception_throw_adhoc(tc, "Cannot get elements of a %s type object", STABLE(obj)->debug_name);
+    return REPR(obj)->pos_funcs.pos_as_atomic(tc, STABLE(obj), obj, OBJECT_BODY(obj), idx, kind);
+}
+
+/* Atomic operations on an object slot, at an address got from one of the
+ * above, in the given holder object. A slot that was never set holds NULL,
+ * which is seen as VMNull. Storing applies the write barrier to the holder,
+ * before the store as MVM_ASSIGN_REF does; for a compare and swap that fails
+ * this is merely conservative. */
+MVM_PUBLIC MVMObject * MVM_repr_atomic_cas_o(MVMThreadContext *tc, MVMObject *holder, AO_t *target,
+                                             MVMObject *expected, MVMObject *value) {
+    MVMObject *seen;
+    MVM_gc_write_barrier(tc, &(holder->header), (MVMCollectable *)value);
+    seen = (MVMObject *)MVM_casptr(target, expected, value);
+    if (!seen && expected == tc->instance->VMNull)
+        seen = (MVMObject *)MVM_casptr(target, NULL, value);
+    return seen ? seen : tc->instance->VMNull;
+}
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_o(MVMThreadContext *tc, AO_t *target) {
+    MVMObject *value = (MVMObject *)MVM_load(target);
+    return value ? value : tc->instance->VMNull;
+}
+MVM_PUBLIC void MVM_repr_atomic_bind_o(MVMThreadContext *tc, MVMObject *holder, AO_t *target,
+                                       MVMObject *value) {
+    MVM_gc_write_barrier(tc, &(holder->header), (MVMCollectable *)value);
+    MVM_store(target, value);
+}
+
+/* The atomic object ops on attributes and elements, for the interpreter and
+ * the JIT to share. */
+MVM_PUBLIC MVMObject * MVM_repr_cas_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                           MVMString *name, MVMObject *expected, MVMObject *value) {
+    AO_t      *target = MVM_repr_attribute_as_atomic(tc, obj, type, name, MVM_reg_obj);
+    MVMObject *seen   = MVM_repr_atomic_cas_o(tc, obj, target, expected, value);
+    MVM_SC_WB_OBJ(tc, obj);
+    return seen;
+}
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                                   MVMString *name) {
+    return MVM_repr_atomic_load_o(tc,
+        MVM_repr_attribute_as_atomic(tc, obj, type, name, MVM_reg_obj));
+}
+MVM_PUBLIC void MVM_repr_atomic_bind_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                            MVMString *name, MVMObject *value) {
+    MVM_repr_atomic_bind_o(tc, obj,
+        MVM_repr_attribute_as_atomic(tc, obj, type, name, MVM_reg_obj), value);
+    MVM_SC_WB_OBJ(tc, obj);
+}
+MVM_PUBLIC MVMObject * MVM_repr_cas_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx,
+                                          MVMObject *expected, MVMObject *value) {
+    AO_t      *target = MVM_repr_pos_as_atomic(tc, obj, idx, MVM_reg_obj);
+    MVMObject *seen   = MVM_repr_atomic_cas_o(tc, obj, target, expected, value);
+    MVM_SC_WB_OBJ(tc, obj);
+    return seen;
+}
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx) {
+    return MVM_repr_atomic_load_o(tc, MVM_repr_pos_as_atomic(tc, obj, idx, MVM_reg_obj));
+}
+MVM_PUBLIC void MVM_repr_atomic_bind_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx,
+                                           MVMObject *value) {
+    MVM_repr_atomic_bind_o(tc, obj, MVM_repr_pos_as_atomic(tc, obj, idx, MVM_reg_obj), value);
+    MVM_SC_WB_OBJ(tc, obj);
+}
+
 MVM_PUBLIC MVMint64    MVM_repr_compare_repr_id(MVMThreadContext *tc, MVMObject *object, MVMuint32 REPRId) {
     return object && REPR(object)->ID == REPRId ? 1 : 0;
 }
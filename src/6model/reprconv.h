@@ -115,6 +115,26 @@ MVM_PUBLIC void        MVM_repr_bind_attr_inso(MVMThreadContext *tc, MVMObject *
 MVM_PUBLIC MVMint64   MVM_repr_attribute_inited(MVMThreadContext *tc, MVMObject *object, MVMObject *type,
                                                 MVMString *name);
 
+MVM_PUBLIC AO_t *      MVM_repr_attribute_as_atomic(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                                   MVMString *name, MVMuint16 kind);
+MVM_PUBLIC AO_t *      MVM_repr_pos_as_atomic(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx, MVMuint16 kind);
+MVM_PUBLIC MVMObject * MVM_repr_atomic_cas_o(MVMThreadContext *tc, MVMObject *holder, AO_t *target,
+                                             MVMObject *expected, MVMObject *value);
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_o(MVMThreadContext *tc, AO_t *target);
+MVM_PUBLIC void        MVM_repr_atomic_bind_o(MVMThreadContext *tc, MVMObject *holder, AO_t *target,
+                                             MVMObject *value);
+MVM_PUBLIC MVMObject * MVM_repr_cas_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                           MVMString *name, MVMObject *expected, MVMObject *value);
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                                   MVMString *name);
+MVM_PUBLIC void        MVM_repr_atomic_bind_attr_o(MVMThreadContext *tc, MVMObject *obj, MVMObject *type,
+                                                   MVMString *name, MVMObject *value);
+MVM_PUBLIC MVMObject * MVM_repr_cas_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx,
+                                          MVMObject *expected, MVMObject *value);
+MVM_PUBLIC MVMObject * MVM_repr_atomic_load_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx);
+MVM_PUBLIC void        MVM_repr_atomic_bind_pos_o(MVMThreadContext *tc, MVMObject *obj, MVMint64 idx,
+                                                  MVMObject *value);
+
 MVM_PUBLIC MVMint64    MVM_repr_compare_repr_id(MVMThreadContext *tc, MVMObject *object, MVMuint32 REPRId);
 
 MVM_PUBLIC MVMint64    MVM_repr_hint_for(MVMThreadContext *tc, MVMObject *object, MVMString *attrname);
@@ -28,6 +28,13 @@ GCC_DIAG_ON(return-type)
 MVMint64 MVM_REPR_DEFAULT_HINT_FOR(MVMThreadContext *tc, MVMSTable *st, MVMObject *class_handle, MVMString *name) {
     return MVM_NO_HINT;
 }
+GCC_DIAG_OFF(return-type)
+AO_t * MVM_REPR_DEFAULT_ATTRIBUTE_AS_ATOMIC(MVMThreadContext *tc, MVMSTable *st, void *data, MVMObject *class_handle, MVMString *name, MVMuint16 kind) {
+    MVM_exception_throw_adhoc(tc,
+        "Cannot perform atomic operations on attributes of a %s representation (for type %s)",
+        st->REPR->name, st->debug_name);
+}
+GCC_DIAG_ON(return-type)
 void MVM_REPR_DEFAULT_SET_INT(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 value) {
     MVM_exception_throw_adhoc(tc,
         "This representation (%s) cannot box a native int (for type %s)", st->REPR->name, st->debug_name);
@@ -107,6 +114,13 @@ MVMStorageSpec MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC(MVMThreadContext *tc, MVMS
     die_no_pos(tc, st->REPR->name, st->debug_name);
 }
 GCC_DIAG_ON(return-type)
+GCC_DIAG_OFF(return-type)
+AO_t * MVM_REPR_DEFAULT_POS_AS_ATOMIC(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMuint16 kind) {
+    MVM_exception_throw_adhoc(tc,
+        "Cannot perform atomic operations on elements of a %s representation (for type %s)",
+        st->REPR->name, st->debug_name);
+}
+GCC_DIAG_ON(return-type)
 void MVM_REPR_DEFAULT_SPLICE(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *target_array, MVMint64 offset, MVMuint64 elems) {
     die_no_pos(tc, st->REPR->name, st->debug_name);
 }
@@ -239,6 +253,9 @@ void MVM_repr_initialize_registry(MVMThreadContext *tc) {
     register_core_repr(NativeRef);
     register_core_repr(MultiDimArray);
     register_core_repr(Decoder);
+    register_core_repr(StringBuilder);
+    register_core_repr(ConcHash);
+    register_core_repr(ConcScheduler);
 
     tc->instance->num_reprs = MVM_REPR_CORE_COUNT;
 }
@@ -43,6 +43,9 @@
 #include "6model/reprs/NativeRef.h"
 #include "6model/reprs/MultiDimArray.h"
 #include "6model/reprs/Decoder.h"
+#include "6model/reprs/StringBuilder.h"
+#include "6model/reprs/ConcHash.h"
+#include "6model/reprs/ConcScheduler.h"
 
 /* REPR related functions. */
 void MVM_repr_initialize_registry(MVMThreadContext *tc);
@@ -96,8 +99,11 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
 #define MVM_REPR_ID_MultiDimArray           41
 #define MVM_REPR_ID_MVMCPPStruct            42
 #define MVM_REPR_ID_Decoder                 43
+#define MVM_REPR_ID_StringBuilder           44
+#define MVM_REPR_ID_ConcHash                45
+#define MVM_REPR_ID_ConcScheduler           46
 
-#define MVM_REPR_CORE_COUNT                 44
+#define MVM_REPR_CORE_COUNT                 47
 #define MVM_REPR_MAX_COUNT                  64
 
 /* Default attribute functions for a REPR that lacks them. */
@@ -106,7 +112,8 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
     MVM_REPR_DEFAULT_GET_ATTRIBUTE, \
     MVM_REPR_DEFAULT_BIND_ATTRIBUTE, \
     MVM_REPR_DEFAULT_HINT_FOR, \
-    MVM_REPR_DEFAULT_IS_ATTRIBUTE_INITIALIZED \
+    MVM_REPR_DEFAULT_IS_ATTRIBUTE_INITIALIZED, \
+    MVM_REPR_DEFAULT_ATTRIBUTE_AS_ATOMIC \
 }
 
 /* Default boxing functions for a REPR that lacks them. */
@@ -138,7 +145,8 @@ const MVMREPROps * MVM_repr_get_by_name(MVMThreadContext *tc, MVMString *name);
     MVM_REPR_DEFAULT_BIND_POS_MULTIDIM, \
     MVM_REPR_DEFAULT_DIMENSIONS, \
     MVM_REPR_DEFAULT_SET_DIMENSIONS, \
-    MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC \
+    MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC, \
+    MVM_REPR_DEFAULT_POS_AS_ATOMIC \
 }
 
 /* Default associative functions for a REPR that lacks them. */
@@ -168,6 +176,7 @@ void MVM_REPR_DEFAULT_GET_ATTRIBUTE(MVMThreadContext *tc, MVMSTable *st, MVMObje
 void MVM_REPR_DEFAULT_BIND_ATTRIBUTE(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *class_handle, MVMString *name, MVMint64 hint, MVMRegister value, MVMuint16 kind);
 MVMint64 MVM_REPR_DEFAULT_IS_ATTRIBUTE_INITIALIZED(MVMThreadContext *tc, MVMSTable *st, void *data, MVMObject *class_handle, MVMString *name, MVMint64 hint);
 MVMint64 MVM_REPR_DEFAULT_HINT_FOR(MVMThreadContext *tc, MVMSTable *st, MVMObject *class_handle, MVMString *name);
+AO_t * MVM_REPR_DEFAULT_ATTRIBUTE_AS_ATOMIC(MVMThreadContext *tc, MVMSTable *st, void *data, MVMObject *class_handle, MVMString *name, MVMuint16 kind);
 
 /* Default boxing REPR function for a REPR that lacks it. */
 void MVM_REPR_DEFAULT_SET_INT(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 value);
@@ -193,6 +202,7 @@ void MVM_REPR_DEFAULT_BIND_POS_MULTIDIM(MVMThreadContext *tc, MVMSTable *st, MVM
 void MVM_REPR_DEFAULT_DIMENSIONS(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 *num_dimensions, MVMint64 **dimensions);
 void MVM_REPR_DEFAULT_SET_DIMENSIONS(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 num_dimensions, MVMint64 *dimensions);
 MVMStorageSpec MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC(MVMThreadContext *tc, MVMSTable *st);
+AO_t * MVM_REPR_DEFAULT_POS_AS_ATOMIC(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMuint16 kind);
 
 /* Default associative indexing REPR function for a REPR that lacks it. */
 void MVM_REPR_DEFAULT_SPLICE(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *target_array, MVMint64 offset, MVMuint64 elems);
@@ -17,6 +17,16 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
     return st->WHAT;
 }
 
+/* Marker stored into a slot once its value has been taken, or when a taker
+ * claims a slot that a pusher has not yet stored into. */
+static char taken_marker;
+#define TAKEN ((MVMObject *)&taken_marker)
+
+static MVMConcBlockingQueueSegment * alloc_segment(MVMThreadContext *tc) {
+    return MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        sizeof(MVMConcBlockingQueueSegment));
+}
+
 /* Initializes a new instance. */
 static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
@@ -24,18 +34,15 @@ static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
     /* Initialize locks. */
     int init_stat;
     cbq->locks = MVM_calloc(1, sizeof(MVMConcBlockingQueueLocks));
-    if ((init_stat = uv_mutex_init(&cbq->locks->head_lock)) < 0)
+    if ((init_stat = uv_mutex_init(&cbq->locks->lock)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
             uv_strerror(init_stat));
-    if ((init_stat = uv_mutex_init(&cbq->locks->tail_lock)) < 0)
-        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
-            uv_strerror(init_stat));
-    if ((init_stat = uv_cond_init(&cbq->locks->head_cond)) < 0)
+    if ((init_stat = uv_cond_init(&cbq->locks->cond)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
             uv_strerror(init_stat));
 
-    /* Head and tail point to a null node. */
-    cbq->tail = cbq->head = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
+    /* Head and tail point to an empty segment. */
+    cbq->tail = cbq->head = alloc_segment(tc);
 }
 
 /* Copies the body of one object to another. */
@@ -46,11 +53,15 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 /* Called by the VM to mark any GCable items. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     /* At this point we know the world is stopped, and thus we can safely do a
-     * traversal of the data structure without needing locks. */
-    MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *cur = cbq->head;
+     * traversal of the data structure without needing locks; no push or take
+     * is part way done, since they don't reach a safepoint. */
+    MVMConcBlockingQueueBody    *cbq = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueSegment *cur = cbq->head;
     while (cur) {
-        MVM_gc_worklist_add(tc, worklist, &cur->value);
+        MVMuint32 i;
+        for (i = 0; i < MVM_CBQ_SEGMENT_SLOTS; i++)
+            if (cur->slots[i] && cur->slots[i] != TAKEN)
+                MVM_gc_worklist_add(tc, worklist, &cur->slots[i]);
         cur = cur->next;
     }
 }
@@ -59,19 +70,18 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)obj;
 
-    /* First, free all the nodes. */
-    MVMConcBlockingQueueNode *cur = cbq->body.head;
+    /* First, free all the segments. */
+    MVMConcBlockingQueueSegment *cur = cbq->body.head;
     while (cur) {
-        MVMConcBlockingQueueNode *next = cur->next;
-        MVM_free(cur);
+        MVMConcBlockingQueueSegment *next = cur->next;
+        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueSegment), cur);
         cur = next;
     }
     cbq->body.head = cbq->body.tail = NULL;
 
     /* Clean up locks. */
-    uv_mutex_destroy(&cbq->body.locks->head_lock);
-    uv_mutex_destroy(&cbq->body.locks->tail_lock);
-    uv_cond_destroy(&cbq->body.locks->head_cond);
+    uv_mutex_destroy(&cbq->body.locks->lock);
+    uv_cond_destroy(&cbq->body.locks->cond);
     MVM_free(cbq->body.locks);
     cbq->body.locks = NULL;
 }
@@ -95,8 +105,117 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
     /* Nothing to do for this REPR. */
 }
 
+/* Adds a value to the tail of the queue. The caller must already have done
+ * the increment of elems. Must not reach a GC safepoint, since it holds on
+ * to segments that may be freed at one. */
+static void enqueue(MVMThreadContext *tc, MVMConcBlockingQueueBody *cbq, MVMObject *root, MVMObject *value) {
+    MVM_gc_write_barrier(tc, &(root->header), &(value->header));
+    while (1) {
+        MVMConcBlockingQueueSegment *tail = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->tail);
+        AO_t idx = MVM_incr(&tail->push_idx);
+        if (idx < MVM_CBQ_SEGMENT_SLOTS) {
+            /* If this fails, a taker gave up on the slot before we got to
+             * store into it; go around again for another. */
+            if (MVM_casptr(&tail->slots[idx], NULL, value) == NULL)
+                return;
+        }
+        else {
+            /* The segment is full. Either link a new one with the value in
+             * its first slot, or help whoever beat us to that move the tail
+             * along. */
+            MVMConcBlockingQueueSegment *next = (MVMConcBlockingQueueSegment *)MVM_load(&tail->next);
+            if (tail != (MVMConcBlockingQueueSegment *)MVM_load(&cbq->tail))
+                continue;
+            if (next) {
+                MVM_casptr(&cbq->tail, tail, next);
+            }
+            else {
+                MVMConcBlockingQueueSegment *seg = alloc_segment(tc);
+                seg->slots[0] = value;
+                seg->push_idx = 1;
+                if (MVM_casptr(&tail->next, NULL, seg) == NULL) {
+                    MVM_casptr(&cbq->tail, tail, seg);
+                    return;
+                }
+                MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueSegment), seg);
+            }
+        }
+    }
+}
+
+/* Takes a value from the head of the queue, returning NULL if it is empty.
+ * As with enqueue, must not reach a GC safepoint. */
+static MVMObject * try_take(MVMThreadContext *tc, MVMConcBlockingQueueBody *cbq) {
+    while (1) {
+        MVMConcBlockingQueueSegment *head = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->head);
+        AO_t idx;
+        if (MVM_load(&head->take_idx) >= MVM_load(&head->push_idx) && !MVM_load(&head->next))
+            return NULL;
+        idx = MVM_incr(&head->take_idx);
+        if (idx < MVM_CBQ_SEGMENT_SLOTS) {
+            /* Either we get the value, or we leave a marker so that the
+             * pusher who claimed the slot but is yet to store into it tries
+             * again elsewhere, and we do likewise. */
+            MVMObject *taken = (MVMObject *)MVM_casptr(&head->slots[idx], NULL, TAKEN);
+            if (taken) {
+                head->slots[idx] = TAKEN;
+                MVM_decr(&cbq->elems);
+                return taken;
+            }
+        }
+        else {
+            /* Segment used up; move on to the next one, if any. Whoever moves
+             * the head frees the segment once every thread is done with it. */
+            MVMConcBlockingQueueSegment *next = (MVMConcBlockingQueueSegment *)MVM_load(&head->next);
+            if (!next)
+                return NULL;
+            if (MVM_casptr(&cbq->head, head, next) == head)
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    sizeof(MVMConcBlockingQueueSegment), head);
+        }
+    }
+}
+
+/* Wakes up takers blocked waiting for values, if there are any. The load of
+ * the waiters count comes after the full barrier of the CAS that made the
+ * value visible, which pairs with takers incrementing it before they make a
+ * last check of the queue, so a wakeup cannot be lost. */
+static void wake_waiters(MVMThreadContext *tc, MVMObject *root, MVMint64 all) {
+    MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+    if (MVM_load(&cbq->waiters)) {
+        MVMConcBlockingQueueLocks *locks = cbq->locks;
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&locks->lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        if (all)
+            uv_cond_broadcast(&locks->cond);
+        else
+            uv_cond_signal(&locks->cond);
+        uv_mutex_unlock(&locks->lock);
+    }
+}
+
+/* Looks at the value at the head of the queue without taking it. */
+static MVMObject * peek(MVMThreadContext *tc, MVMConcBlockingQueueBody *cbq) {
+    MVMConcBlockingQueueSegment *seg = (MVMConcBlockingQueueSegment *)MVM_load(&cbq->head);
+    while (seg) {
+        AO_t idx = MVM_load(&seg->take_idx);
+        AO_t end = MVM_load(&seg->push_idx);
+        if (end > MVM_CBQ_SEGMENT_SLOTS)
+            end = MVM_CBQ_SEGMENT_SLOTS;
+        for (; idx < end; idx++) {
+            MVMObject *found = (MVMObject *)MVM_load(&seg->slots[idx]);
+            if (found && found != TAKEN)
+                return found;
+        }
+        seg = (MVMConcBlockingQueueSegment *)MVM_load(&seg->next);
+    }
+    return NULL;
+}
+
 static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
+    MVMObject *peeked;
 
     if (index != 0)
         MVM_exception_throw_adhoc(tc,
@@ -105,38 +224,17 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
         MVM_exception_throw_adhoc(tc,
             "Can only get objects from a concurrent blocking queue");
 
-    if (MVM_load(&cbq->elems) > 0) {
-        MVMConcBlockingQueueNode *peeked;
-        unsigned int interval_id;
-        interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.at_pos");
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-            data = OBJECT_BODY(root);
-            cbq = (MVMConcBlockingQueueBody *)data;
-        });
-        peeked = cbq->head->next;
-        value->o = peeked ? peeked->value : tc->instance->VMNull;
-        uv_mutex_unlock(&cbq->locks->head_lock);
-        MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.at_pos");
-    }
-    else {
-        value->o = tc->instance->VMNull;
-    }
+    peeked = peek(tc, cbq);
+    value->o = peeked ? peeked : tc->instance->VMNull;
 }
 
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    return MVM_load(cbq->elems);
+    return MVM_load(&cbq->elems);
 }
 
 static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *add;
-    AO_t orig_elems;
-    MVMObject *to_add = value.o;
-    unsigned int interval_id;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc,
@@ -145,76 +243,43 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
         MVM_exception_throw_adhoc(tc,
             "Cannot store a null value in a concurrent blocking queue");
 
-    add = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
-
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.push");
-    MVMROOT(tc, root, {
-    MVMROOT(tc, to_add, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->tail_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
-    });
-    data = OBJECT_BODY(root);
-    cbq = (MVMConcBlockingQueueBody *)data;
-    MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
-    cbq->tail->next = add;
-    cbq->tail = add;
-    orig_elems = MVM_incr(&cbq->elems);
-    uv_mutex_unlock(&cbq->locks->tail_lock);
-
-    if (orig_elems == 0) {
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
-        data = OBJECT_BODY(root);
-        cbq = (MVMConcBlockingQueueBody *)data;
-        uv_cond_signal(&cbq->locks->head_cond);
-        uv_mutex_unlock(&cbq->locks->head_lock);
-    }
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.push");
+    MVM_incr(&cbq->elems);
+    enqueue(tc, cbq, root, value.o);
+    wake_waiters(tc, root, 0);
 }
 
 static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *taken;
-    unsigned int interval_id;
+    MVMObject *taken;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc, "Can only shift objects from a ConcBlockingQueue");
 
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.shift");
-    MVMROOT(tc, root, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-        data = OBJECT_BODY(root);
-        cbq  = (MVMConcBlockingQueueBody *)data;
-
-        while (MVM_load(&cbq->elems) == 0) {
+    taken = try_take(tc, cbq);
+    if (!taken) {
+        /* Nothing available; register as a waiter, then check again before
+         * sleeping, in case a pusher missed seeing us. */
+        MVMConcBlockingQueueLocks *locks = cbq->locks;
+        unsigned int interval_id;
+        interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.shift");
+        MVMROOT(tc, root, {
+            MVM_gc_mark_thread_blocked(tc);
+            uv_mutex_lock(&locks->lock);
+            MVM_gc_mark_thread_unblocked(tc);
+            cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+            MVM_incr(&cbq->waiters);
+            while (!(taken = try_take(tc, cbq))) {
                 MVM_gc_mark_thread_blocked(tc);
-                uv_cond_wait(&cbq->locks->head_cond, &cbq->locks->head_lock);
+                uv_cond_wait(&locks->cond, &locks->lock);
                 MVM_gc_mark_thread_unblocked(tc);
-                data = OBJECT_BODY(root);
-                cbq  = (MVMConcBlockingQueueBody *)data;
-        }
-    });
-
-    taken = cbq->head->next;
-    MVM_free(cbq->head);
-    cbq->head = taken;
-    MVM_barrier();
-    value->o = taken->value;
-    taken->value = NULL;
-    MVM_barrier();
-
-    if (MVM_decr(&cbq->elems) > 1)
-        uv_cond_signal(&cbq->locks->head_cond);
-
-    uv_mutex_unlock(&cbq->locks->head_lock);
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift");
+                cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+            }
+            MVM_decr(&cbq->waiters);
+            uv_mutex_unlock(&locks->lock);
+        });
+        MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift");
+    }
+    value->o = taken;
 }
 
 /* Set the size of the STable. */
@@ -247,7 +312,8 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
         MVM_REPR_DEFAULT_BIND_POS_MULTIDIM,
         MVM_REPR_DEFAULT_DIMENSIONS,
         MVM_REPR_DEFAULT_SET_DIMENSIONS,
-        MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC
+        MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
@@ -273,32 +339,58 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
 
 /* Polls a queue for a value, returning NULL if none is available. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue) {
-    MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)queue;
-    MVMConcBlockingQueueNode *taken;
-    MVMObject *result = tc->instance->VMNull;
-    unsigned int interval_id;
-
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll");
-    MVMROOT(tc, cbq, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->body.locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
+    MVMObject *taken = try_take(tc, &queue->body);
+    return taken ? taken : tc->instance->VMNull;
+}
 
-    if (MVM_load(&cbq->body.elems) > 0) {
-        taken = cbq->body.head->next;
-        MVM_free(cbq->body.head);
-        cbq->body.head = taken;
-        MVM_barrier();
-        result = taken->value;
-        taken->value = NULL;
-        MVM_barrier();
-        if (MVM_decr(&cbq->body.elems) > 1)
-            uv_cond_signal(&cbq->body.locks->head_cond);
-    }
+/* Checks that an object passed to one of the batch ops is a queue. */
+static MVMConcBlockingQueueBody * get_queue_body(MVMThreadContext *tc, MVMObject *queue, const char *op) {
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue || !IS_CONCRETE(queue))
+        MVM_exception_throw_adhoc(tc,
+            "%s requires a concrete object with REPR ConcBlockingQueue", op);
+    return &((MVMConcBlockingQueue *)queue)->body;
+}
 
-    uv_mutex_unlock(&cbq->body.locks->head_lock);
+/* Pushes all of the values in an object array onto a queue, waking waiting
+ * takers at most once. */
+void MVM_concblockingqueue_push_batch(MVMThreadContext *tc, MVMObject *queue, MVMObject *values) {
+    MVMConcBlockingQueueBody *cbq = get_queue_body(tc, queue, "queuepushbatch");
+    MVMint64 n, i;
+    if (REPR(values)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(values)
+            || ((MVMArrayREPRData *)STABLE(values)->REPR_data)->slot_type != MVM_ARRAY_OBJ)
+        MVM_exception_throw_adhoc(tc,
+            "queuepushbatch requires a concrete object array of values");
+
+    /* Reading the array cannot reach a safepoint, so the queue won't move. */
+    n = MVM_repr_elems(tc, values);
+    if (n == 0)
+        return;
+    MVM_add(&cbq->elems, n);
+    for (i = 0; i < n; i++)
+        enqueue(tc, cbq, queue, MVM_repr_at_pos_o(tc, values, i));
+    wake_waiters(tc, queue, n > 1);
+}
 
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.poll");
-    return result;
+/* Takes up to max values from a queue without blocking, pushing them onto the
+ * target object array. Returns the number of values taken. */
+MVMint64 MVM_concblockingqueue_poll_batch(MVMThreadContext *tc, MVMObject *queue,
+        MVMObject *target, MVMint64 max) {
+    MVMConcBlockingQueueBody *cbq   = get_queue_body(tc, queue, "queuepollbatch");
+    MVMint64                  taken = 0;
+    if (REPR(target)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(target)
+            || ((MVMArrayREPRData *)STABLE(target)->REPR_data)->slot_type != MVM_ARRAY_OBJ)
+        MVM_exception_throw_adhoc(tc,
+            "queuepollbatch requires a concrete object array to poll into");
+
+    /* Pushing to an object array cannot reach a safepoint, so neither object
+     * will move and each value is anchored in the target as soon as it is
+     * taken. */
+    while (taken < max) {
+        MVMObject *value = try_take(tc, cbq);
+        if (!value)
+            break;
+        MVM_repr_push_o(tc, target, value);
+        taken++;
+    }
+    return taken;
 }
@@ -1,27 +1,46 @@
-/* A single node in the concurrent blocking queue. */
-struct MVMConcBlockingQueueNode {
-    MVMObject                *value;
-    MVMConcBlockingQueueNode *next;
+/* Number of value slots in each segment of a concurrent blocking queue. */
+#define MVM_CBQ_SEGMENT_SLOTS 64
+
+/* A segment of the concurrent blocking queue. Pushers claim a slot by doing
+ * an atomic increment of push_idx and then CAS the value into it; takers
+ * claim a slot by an atomic increment of take_idx and then CAS a marker into
+ * it, which either gets them the value or, if the pusher that claimed the
+ * slot has not yet stored into it, makes that pusher try again elsewhere.
+ * Once a segment is filled, a new one is linked on to the end; the indexes
+ * may run past the number of slots as threads race to notice this. */
+struct MVMConcBlockingQueueSegment {
+    MVMConcBlockingQueueSegment *next;
+    AO_t                         push_idx;
+    AO_t                         take_idx;
+    MVMObject                   *slots[MVM_CBQ_SEGMENT_SLOTS];
 };
 
-/* Memory used for mutexes and cond vars; these can't live in the object body
- * directly as they are sensitive to being moved, but putting them together in
- * a single struct means we can malloc a single bit of memory to hold them. */
+/* Memory used for the mutex and cond var, which are only used to park takers
+ * when the queue is empty; these can't live in the object body directly as
+ * they are sensitive to being moved, but putting them together in a single
+ * struct means we can malloc a single bit of memory to hold them. */
 struct MVMConcBlockingQueueLocks {
-    uv_mutex_t  head_lock;
-    uv_mutex_t  tail_lock;
-    uv_cond_t   head_cond;
+    uv_mutex_t  lock;
+    uv_cond_t   cond;
 };
 
 /* Representation used for concurrent blocking queue. */
 struct MVMConcBlockingQueueBody {
-    /* Head and tail of the queue. */
-    MVMConcBlockingQueueNode *head;
-    MVMConcBlockingQueueNode *tail;
+    /* Head and tail segments of the queue. Segments that are emptied are
+     * freed at the next GC safepoint, so they can be used without locking
+     * by any thread until it next reaches one. */
+    MVMConcBlockingQueueSegment *head;
+    MVMConcBlockingQueueSegment *tail;
 
-    /* Number of elements currently in the queue. */
+    /* Number of elements currently in the queue. This is incremented before
+     * an element is made available and decremented after it is taken, so it
+     * may briefly over-count, but never under-counts. */
     AO_t elems;
 
+    /* Number of takers blocked waiting for an element. Pushers only need to
+     * touch the lock and cond var when this is non-zero. */
+    AO_t waiters;
+
     /* Locks and condition variables storage. */
     MVMConcBlockingQueueLocks *locks;
 };
@@ -35,3 +54,6 @@ const MVMREPROps * MVMConcBlockingQueue_initialize(MVMThreadContext *tc);
 
 /* Operations on concurrent blocking queues. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue);
+void MVM_concblockingqueue_push_batch(MVMThreadContext *tc, MVMObject *queue, MVMObject *values);
+MVMint64 MVM_concblockingqueue_poll_batch(MVMThreadContext *tc, MVMObject *queue,
+    MVMObject *target, MVMint64 max);
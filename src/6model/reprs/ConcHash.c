@@ -0,0 +1,403 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcHash_this_repr;
+
+MVM_STATIC_INLINE MVMString * get_string_key(MVMThreadContext *tc, MVMObject *key) {
+    if (!key || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key))
+        MVM_exception_throw_adhoc(tc, "ConcHash representation requires MVMString keys");
+    return (MVMString *)key;
+}
+
+/* Picks the stripe for a key using the top bits of its hash code, since the
+ * table within the stripe probes starting from the bottom ones. */
+MVM_STATIC_INLINE MVMConcHashStripe * get_stripe(MVMThreadContext *tc, MVMConcHashStripe *stripes, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return &(stripes[(MVMuint32)key->body.cached_hash_code >> (32 - MVM_CONC_HASH_STRIPE_BITS)]);
+}
+
+/* Gets the table currently published for a stripe; may be NULL. */
+MVM_STATIC_INLINE MVMStrHashTable * current_table(MVMConcHashStripe *stripe) {
+    return (MVMStrHashTable *)MVM_load(&(stripe->table));
+}
+
+/* Sets up the (empty) stripes and their locks. */
+static void setup_stripes(MVMThreadContext *tc, MVMConcHashBody *body) {
+    MVMuint32 i;
+    int init_stat;
+    body->stripes = MVM_calloc(MVM_CONC_HASH_STRIPES, sizeof(MVMConcHashStripe));
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++)
+        if ((init_stat = uv_mutex_init(&(body->stripes[i].lock))) < 0)
+            MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+                uv_strerror(init_stat));
+}
+
+/* Takes the lock on a stripe. If we have to wait for it, we mark ourselves
+ * blocked so that GC can go ahead without us, and so root the things we're
+ * working with. */
+static void lock_stripe(MVMThreadContext *tc, MVMConcHashStripe *stripe, MVMObject **root, MVMString **key, MVMObject **value) {
+    if (uv_mutex_trylock(&(stripe->lock)) != 0) {
+        MVMROOT(tc, *root, {
+        MVMROOT(tc, *key, {
+        MVMROOT(tc, *value, {
+            MVM_gc_mark_thread_blocked(tc);
+            uv_mutex_lock(&(stripe->lock));
+            MVM_gc_mark_thread_unblocked(tc);
+        });
+        });
+        });
+    }
+}
+
+/* Makes a copy of a stripe's table (which may be NULL) to be changed. */
+static MVMStrHashTable * copy_table(MVMThreadContext *tc, MVMStrHashTable *table) {
+    MVMStrHashTable *copy = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        sizeof(MVMStrHashTable));
+    if (table)
+        MVM_str_hash_copy(tc, copy, table);
+    return copy;
+}
+
+/* Publishes a changed table for a stripe. Readers may still be looking at
+ * the one it replaces, so that is only freed at the next safepoint. Must be
+ * called with the stripe's lock held. */
+static void publish_table(MVMThreadContext *tc, MVMConcHashStripe *stripe, MVMStrHashTable *table) {
+    MVMStrHashTable *old = stripe->table;
+    MVM_store(&(stripe->table), table);
+    if (old) {
+        if (old->alloc_entries)
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                MVM_STR_HASH_ALLOC_SIZE(old->alloc_entries), old->entries);
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+            sizeof(MVMStrHashTable), old);
+    }
+}
+
+/* Builds a VMHash holding what is in the stripes. */
+static MVMObject * snapshot_stripes(MVMThreadContext *tc, MVMConcHashStripe *stripes) {
+    MVMObject       *result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    MVMStrHashTable *dest   = &(((MVMHash *)result)->body.hashtable);
+    MVMuint32 i, j;
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *table = current_table(&(stripes[i]));
+        if (!table)
+            continue;
+        for (j = MVM_str_hash_next(table, 0); j < table->num_entries; j = MVM_str_hash_next(table, j + 1)) {
+            MVMString       *key   = table->entries[j].key;
+            MVMStrHashEntry *entry = MVM_str_hash_lvalue_fetch(tc, dest, key);
+            MVM_gc_write_barrier(tc, &(result->header), &(key->common.header));
+            MVM_ASSIGN_REF(tc, &(result->header), entry->value, table->entries[j].value);
+        }
+    }
+    return result;
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &ConcHash_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcHash);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    setup_stripes(tc, (MVMConcHashBody *)data);
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMConcHashBody *src_body  = (MVMConcHashBody *)src;
+    MVMConcHashBody *dest_body = (MVMConcHashBody *)dest;
+    MVMuint32 i, j;
+
+    setup_stripes(tc, dest_body);
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *src_table = current_table(&(src_body->stripes[i]));
+        MVMStrHashTable *table;
+        if (!src_table)
+            continue;
+        table = copy_table(tc, src_table);
+        for (j = MVM_str_hash_next(table, 0); j < table->num_entries; j = MVM_str_hash_next(table, j + 1)) {
+            MVM_gc_write_barrier(tc, &(dest_root->header),
+                &(table->entries[j].key->common.header));
+            MVM_gc_write_barrier(tc, &(dest_root->header),
+                (MVMCollectable *)table->entries[j].value);
+        }
+        dest_body->stripes[i].table = table;
+    }
+}
+
+/* Adds held objects to the GC worklist. The world is stopped, so the tables
+ * can't change under us. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMuint32 i, j;
+    if (!body->stripes)
+        return;
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *table = body->stripes[i].table;
+        if (!table)
+            continue;
+        for (j = MVM_str_hash_next(table, 0); j < table->num_entries; j = MVM_str_hash_next(table, j + 1)) {
+            MVM_gc_worklist_add(tc, worklist, &(table->entries[j].key));
+            MVM_gc_worklist_add(tc, worklist, &(table->entries[j].value));
+        }
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcHash *ch = (MVMConcHash *)obj;
+    MVMuint32 i;
+    if (!ch->body.stripes)
+        return;
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *table = ch->body.stripes[i].table;
+        if (table) {
+            MVM_str_hash_demolish(tc, table);
+            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMStrHashTable), table);
+        }
+        uv_mutex_destroy(&(ch->body.stripes[i].lock));
+    }
+    MVM_free(ch->body.stripes);
+    ch->body.stripes = NULL;
+}
+
+static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMString       *key  = get_string_key(tc, key_obj);
+    MVMStrHashTable *table;
+    MVMStrHashEntry *entry;
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+    table = current_table(get_stripe(tc, body->stripes, key));
+    entry = table ? MVM_str_hash_fetch(tc, table, key) : NULL;
+    result->o = entry ? entry->value : tc->instance->VMNull;
+}
+
+static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
+    MVMConcHashBody   *body      = (MVMConcHashBody *)data;
+    MVMString         *key       = get_string_key(tc, key_obj);
+    MVMObject         *value_obj = value.o;
+    MVMConcHashStripe *stripe;
+    MVMStrHashTable   *table;
+    MVMStrHashEntry   *entry;
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+
+    stripe = get_stripe(tc, body->stripes, key);
+    lock_stripe(tc, stripe, &root, &key, &value_obj);
+    table = stripe->table;
+    entry = table ? MVM_str_hash_fetch(tc, table, key) : NULL;
+    if (entry) {
+        /* Replacing the value of an existing key can be done in place;
+         * readers will see either the old or the new one. */
+        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_obj);
+    }
+    else {
+        /* If there's room, the new key is added in place, with readers only
+         * seeing it once it's complete. Growing moves things around in the
+         * table, though, so for that we make a bigger copy and publish it. */
+        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
+        MVM_gc_write_barrier(tc, &(root->header), (MVMCollectable *)value_obj);
+        if (!table || !MVM_str_hash_append_in_place(tc, table, key, value_obj)) {
+            table = copy_table(tc, table);
+            entry = MVM_str_hash_lvalue_fetch(tc, table, key);
+            entry->value = value_obj;
+            publish_table(tc, stripe, table);
+        }
+    }
+    uv_mutex_unlock(&(stripe->lock));
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMuint64 count = 0;
+    MVMuint32 i;
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *table = current_table(&(body->stripes[i]));
+        if (table)
+            count += MVM_str_hash_count(table);
+    }
+    return count;
+}
+
+static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody *body  = (MVMConcHashBody *)data;
+    MVMString       *key   = get_string_key(tc, key_obj);
+    MVMStrHashTable *table = current_table(get_stripe(tc, body->stripes, key));
+    return table && MVM_str_hash_fetch(tc, table, key) != NULL;
+}
+
+static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody   *body     = (MVMConcHashBody *)data;
+    MVMString         *key      = get_string_key(tc, key_obj);
+    MVMObject         *no_value = NULL;
+    MVMConcHashStripe *stripe   = get_stripe(tc, body->stripes, key);
+    MVMStrHashTable   *table    = current_table(stripe);
+
+    /* Nothing to do (and no lock to take) if the key isn't there. */
+    if (!table || !MVM_str_hash_fetch(tc, table, key))
+        return;
+
+    lock_stripe(tc, stripe, &root, &key, &no_value);
+    table = stripe->table;
+    if (table && MVM_str_hash_fetch(tc, table, key)) {
+        table = copy_table(tc, table);
+        MVM_str_hash_delete(tc, table, key);
+        publish_table(tc, stripe, table);
+    }
+    uv_mutex_unlock(&(stripe->lock));
+}
+
+static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+    spec.can_box         = 0;
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+    return spec;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Deserialize the representation. Deserialized objects are not initialized,
+ * so we set up the stripes here. */
+static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMSerializationReader *reader) {
+    MVMConcHashBody   *body = (MVMConcHashBody *)data;
+    MVMConcHashStripe *stripes;
+    MVMint64 elems, i;
+    if (!body->stripes)
+        setup_stripes(tc, body);
+    stripes = body->stripes;
+    elems   = MVM_serialization_read_int(tc, reader);
+    for (i = 0; i < elems; i++) {
+        MVMString         *key    = MVM_serialization_read_str(tc, reader);
+        MVMObject         *value  = MVM_serialization_read_ref(tc, reader);
+        MVMConcHashStripe *stripe = get_stripe(tc, stripes, key);
+        MVMStrHashEntry   *entry;
+        if (!stripe->table)
+            stripe->table = copy_table(tc, NULL);
+        entry = MVM_str_hash_lvalue_fetch(tc, stripe->table, key);
+        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
+        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value);
+    }
+}
+
+/* Serialize the representation. This is the same format as VMHash uses, so
+ * we take a snapshot and have that serialize itself. */
+static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
+    MVMObject *snapshot = snapshot_stripes(tc, ((MVMConcHashBody *)data)->stripes);
+    MVMROOT(tc, snapshot, {
+        REPR(snapshot)->serialize(tc, STABLE(snapshot), OBJECT_BODY(snapshot), writer);
+    });
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcHash);
+}
+
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcHashBody *body = (MVMConcHashBody *)data;
+    MVMuint64 size = MVM_CONC_HASH_STRIPES * sizeof(MVMConcHashStripe);
+    MVMuint32 i;
+    for (i = 0; i < MVM_CONC_HASH_STRIPES; i++) {
+        MVMStrHashTable *table = body->stripes[i].table;
+        if (table)
+            size += sizeof(MVMStrHashTable) + MVM_STR_HASH_ALLOC_SIZE(table->alloc_entries);
+    }
+    return size;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc) {
+    return &ConcHash_this_repr;
+}
+
+static const MVMREPROps ConcHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    {
+        at_key,
+        bind_key,
+        exists_key,
+        delete_key,
+        get_value_storage_spec
+    },    /* ass_funcs */
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    serialize,
+    deserialize,
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcHash", /* name */
+    MVM_REPR_ID_ConcHash,
+    unmanaged_size, /* unmanaged_size */
+    NULL, /* describe_refs */
+};
+
+/* Takes a snapshot of a concurrent hash as a VMHash, which can then be
+ * iterated without worrying about other threads changing it. */
+MVMObject * MVM_conc_hash_snapshot(MVMThreadContext *tc, MVMObject *conc) {
+    MVMObject *result;
+    if (REPR(conc)->ID != MVM_REPR_ID_ConcHash || !IS_CONCRETE(conc))
+        MVM_exception_throw_adhoc(tc, "Can only snapshot a concrete ConcHash");
+    MVMROOT(tc, conc, {
+        result = snapshot_stripes(tc, ((MVMConcHash *)conc)->body.stripes);
+    });
+    return result;
+}
+
+/* Gets the table currently published for one of the stripes of a concurrent
+ * hash, or NULL if there is none. Unlike taking a snapshot this does not
+ * allocate; the table stays valid until the next safepoint, so it may be
+ * walked without the stripe's lock as long as nothing in between can GC. */
+MVMStrHashTable * MVM_conc_hash_stripe_table(MVMThreadContext *tc, MVMObject *conc, MVMuint32 stripe) {
+    if (!IS_CONCRETE(conc))
+        return NULL;
+    return current_table(&(((MVMConcHash *)conc)->body.stripes[stripe]));
+}
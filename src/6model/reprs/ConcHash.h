@@ -0,0 +1,35 @@
+/* Number of bits of a key's hash code used to pick its stripe. */
+#define MVM_CONC_HASH_STRIPE_BITS   4
+#define MVM_CONC_HASH_STRIPES       (1 << MVM_CONC_HASH_STRIPE_BITS)
+
+/* A stripe of a concurrent hash. Readers load the table pointer without
+ * taking the lock; writers take the lock, and either update a value or add
+ * a key in place, or (to grow the table or delete from it) build a changed
+ * copy of the table and publish it, freeing the old one at the next
+ * safepoint since readers may still be looking at it. */
+struct MVMConcHashStripe {
+    /* The current table, or NULL if nothing was ever added to the stripe. */
+    MVMStrHashTable *table;
+
+    /* Lock taken by writers to the stripe. */
+    uv_mutex_t lock;
+};
+
+/* Representation used for hashes shared between threads, where lookups are
+ * far more common than changes. */
+struct MVMConcHashBody {
+    /* The stripes; these are allocated separately as the locks in them are
+     * sensitive to being moved. */
+    MVMConcHashStripe *stripes;
+};
+struct MVMConcHash {
+    MVMObject common;
+    MVMConcHashBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc);
+
+/* Operations on concurrent hashes. */
+MVMObject * MVM_conc_hash_snapshot(MVMThreadContext *tc, MVMObject *conc);
+MVMStrHashTable * MVM_conc_hash_stripe_table(MVMThreadContext *tc, MVMObject *conc, MVMuint32 stripe);
@@ -0,0 +1,381 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcScheduler_this_repr;
+
+/* Size of a deque buffer with the given number of task slots. */
+#define BUFFER_SIZE(slots) (sizeof(MVMConcSchedulerBuffer) + ((slots) - 1) * sizeof(MVMObject *))
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &ConcScheduler_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcScheduler);
+    });
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation ConcScheduler");
+}
+
+/* Called by the VM to mark any GCable items. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    /* The world is stopped, and no deque operation reaches a safepoint part
+     * way through, so the tasks between top and bottom are exactly those in
+     * each deque. */
+    MVMConcSchedulerBody *body = (MVMConcSchedulerBody *)data;
+    MVM_gc_worklist_add(tc, worklist, &body->injected);
+    if (body->pool) {
+        MVMuint32 i;
+        for (i = 0; i < body->pool->num_workers; i++) {
+            MVMConcSchedulerDeque  *deque  = &(body->pool->deques[i]);
+            MVMConcSchedulerBuffer *buffer = deque->buffer;
+            AO_t j;
+            for (j = deque->top; j != deque->bottom; j++)
+                MVM_gc_worklist_add(tc, worklist, &(buffer->tasks[j & buffer->mask]));
+        }
+    }
+}
+
+/* Called by the VM when the object is freed. A started scheduler is kept
+ * alive by its workers, so this only finds a pool at global destruction
+ * (with --full-cleanup). */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcSchedulerPool *pool = ((MVMConcScheduler *)obj)->body.pool;
+    if (pool) {
+        MVMuint32 i;
+        for (i = 0; i < pool->num_workers; i++) {
+            MVMConcSchedulerBuffer *buffer = pool->deques[i].buffer;
+            MVM_fixed_size_free(tc, tc->instance->fsa, BUFFER_SIZE(buffer->mask + 1), buffer);
+        }
+        MVM_free(pool->deques);
+        uv_mutex_destroy(&pool->lock);
+        uv_cond_destroy(&pool->cond);
+        MVM_free(pool);
+        ((MVMConcScheduler *)obj)->body.pool = NULL;
+    }
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcScheduler);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcScheduler_initialize(MVMThreadContext *tc) {
+    return &ConcScheduler_this_repr;
+}
+
+static const MVMREPROps ConcScheduler_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcScheduler", /* name */
+    MVM_REPR_ID_ConcScheduler,
+    NULL, /* unmanaged_size */
+    NULL, /* describe_refs */
+};
+
+static MVMConcSchedulerBuffer * alloc_buffer(MVMThreadContext *tc, AO_t slots) {
+    MVMConcSchedulerBuffer *buffer = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+        BUFFER_SIZE(slots));
+    buffer->mask = slots - 1;
+    return buffer;
+}
+
+/* Doubles the size of a deque's buffer. Only called by the owning worker. */
+static MVMConcSchedulerBuffer * grow_buffer(MVMThreadContext *tc, MVMConcSchedulerDeque *deque,
+        MVMConcSchedulerBuffer *old, AO_t top, AO_t bottom) {
+    MVMConcSchedulerBuffer *buffer = alloc_buffer(tc, (old->mask + 1) * 2);
+    AO_t i;
+    for (i = top; i != bottom; i++)
+        buffer->tasks[i & buffer->mask] = old->tasks[i & old->mask];
+    MVM_store(&deque->buffer, buffer);
+    MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, BUFFER_SIZE(old->mask + 1), old);
+    return buffer;
+}
+
+/* Pushes a task onto the bottom of a deque. Only called by the owning worker.
+ * The full barrier of the store to bottom makes the task visible first. */
+static void deque_push(MVMThreadContext *tc, MVMConcSchedulerDeque *deque, MVMObject *task) {
+    AO_t                    bottom = deque->bottom;
+    AO_t                    top    = MVM_load(&deque->top);
+    MVMConcSchedulerBuffer *buffer = deque->buffer;
+    if (bottom - top > buffer->mask)
+        buffer = grow_buffer(tc, deque, buffer, top, bottom);
+    buffer->tasks[bottom & buffer->mask] = task;
+    MVM_store(&deque->bottom, bottom + 1);
+}
+
+/* Takes a task from the bottom of a deque, returning NULL if it is empty.
+ * Only called by the owning worker. Indexes start at 1, so bottom - 1 never
+ * wraps around below top. */
+static MVMObject * deque_take(MVMThreadContext *tc, MVMConcSchedulerDeque *deque) {
+    AO_t                    bottom = deque->bottom - 1;
+    MVMConcSchedulerBuffer *buffer = deque->buffer;
+    MVMObject              *task   = NULL;
+    AO_t                    top;
+
+    /* Claim the bottom slot before looking at top; the full barrier orders
+     * this against thieves claiming the top slot. */
+    MVM_store(&deque->bottom, bottom);
+    top = MVM_load(&deque->top);
+    if (top <= bottom) {
+        task = buffer->tasks[bottom & buffer->mask];
+        if (top == bottom) {
+            /* The last task; race any thieves for it. */
+            if (MVM_cas(&deque->top, top, top + 1) != top)
+                task = NULL;
+            MVM_store(&deque->bottom, bottom + 1);
+        }
+    }
+    else {
+        MVM_store(&deque->bottom, bottom + 1);
+    }
+    return task;
+}
+
+/* Steals a task from the top of another worker's deque, returning NULL if it
+ * is empty or if we lost a race for the task. */
+static MVMObject * deque_steal(MVMThreadContext *tc, MVMConcSchedulerDeque *deque) {
+    AO_t top    = MVM_load(&deque->top);
+    AO_t bottom = MVM_load(&deque->bottom);
+    if (top < bottom) {
+        MVMConcSchedulerBuffer *buffer = (MVMConcSchedulerBuffer *)MVM_load(&deque->buffer);
+        MVMObject              *task   = buffer->tasks[top & buffer->mask];
+        if (MVM_cas(&deque->top, top, top + 1) == top)
+            return task;
+    }
+    return NULL;
+}
+
+/* Wakes a parked worker, if there are any. The load of the sleepers count
+ * comes after the full barrier that made the task visible, and pairs with
+ * workers incrementing it before a last look for tasks, so a wakeup cannot
+ * be lost. */
+static void wake_worker(MVMThreadContext *tc, MVMConcSchedulerPool *pool) {
+    if (MVM_load(&pool->sleepers)) {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&pool->lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        uv_cond_signal(&pool->cond);
+        uv_mutex_unlock(&pool->lock);
+    }
+}
+
+/* Looks for a task for a worker to run: first on its own deque, then among
+ * those submitted from other threads, then by stealing from other workers,
+ * starting with the next one along. Returns NULL if there's nothing to do.
+ * Does not reach a safepoint. */
+static MVMObject * find_task(MVMThreadContext *tc, MVMConcSchedulerBody *body, MVMuint32 worker) {
+    MVMConcSchedulerPool *pool = body->pool;
+    MVMObject            *task = deque_take(tc, &(pool->deques[worker]));
+    MVMuint32             i;
+    if (task)
+        return task;
+    task = MVM_concblockingqueue_poll(tc, (MVMConcBlockingQueue *)body->injected);
+    if (!MVM_is_null(tc, task))
+        return task;
+    for (i = 1; i < pool->num_workers; i++) {
+        task = deque_steal(tc, &(pool->deques[(worker + i) % pool->num_workers]));
+        if (task)
+            return task;
+    }
+    return NULL;
+}
+
+/* Makes the initial invocation of a task in the interpreter, so that the
+ * interpreter is left when it returns. */
+static void task_initial_invoke(MVMThreadContext *tc, void *data) {
+    MVMObject *invokee = MVM_frame_find_invokee(tc, (MVMObject *)data, NULL);
+    STABLE(invokee)->invoke(tc, invokee, MVM_callsite_get_common(tc, MVM_CALLSITE_ID_NULL_ARGS), NULL);
+    tc->thread_entry_frame = tc->cur_frame;
+}
+
+/* The body of a worker thread: runs tasks forever, parking when there are
+ * none to be found. The scheduler is rooted by the thread context. As with
+ * a thread's code, an exception a task does not handle is fatal. */
+static void worker_loop(MVMThreadContext *tc, void *data) {
+    MVMConcSchedulerPool *pool = (MVMConcSchedulerPool *)data;
+
+    /* Set up the cached current usecapture CallCapture, as a thread's initial
+     * invocation would. */
+    tc->cur_usecapture = MVM_repr_alloc_init(tc, tc->instance->CallCapture);
+
+    while (1) {
+        MVMObject *task = find_task(tc, (MVMConcSchedulerBody *)OBJECT_BODY(tc->scheduler),
+            tc->scheduler_worker);
+        if (!task) {
+            /* Nothing to do; register as a sleeper, then look again before
+             * parking, in case a submitter missed seeing us. */
+            MVM_gc_mark_thread_blocked(tc);
+            uv_mutex_lock(&pool->lock);
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_incr(&pool->sleepers);
+            while (!(task = find_task(tc, (MVMConcSchedulerBody *)OBJECT_BODY(tc->scheduler),
+                    tc->scheduler_worker))) {
+                MVM_gc_mark_thread_blocked(tc);
+                uv_cond_wait(&pool->cond, &pool->lock);
+                MVM_gc_mark_thread_unblocked(tc);
+            }
+            MVM_decr(&pool->sleepers);
+            uv_mutex_unlock(&pool->lock);
+        }
+
+        MVM_interp_run(tc, task_initial_invoke, task);
+        tc->thread_entry_frame = NULL;
+    }
+}
+
+static MVMConcSchedulerBody * get_body(MVMThreadContext *tc, MVMObject *scheduler, const char *op) {
+    if (REPR(scheduler)->ID != MVM_REPR_ID_ConcScheduler || !IS_CONCRETE(scheduler))
+        MVM_exception_throw_adhoc(tc,
+            "%s requires a concrete object with REPR ConcScheduler", op);
+    return (MVMConcSchedulerBody *)OBJECT_BODY(scheduler);
+}
+
+/* Starts a scheduler's worker threads. These live as long as the program. */
+void MVM_conc_scheduler_start(MVMThreadContext *tc, MVMObject *scheduler, MVMint64 num_workers) {
+    MVMConcSchedulerPool *pool;
+    MVMObject            *injected;
+    MVMuint32             i;
+    int                   init_stat;
+
+    get_body(tc, scheduler, "schedulerstart");
+    if (num_workers < 1 || num_workers > MVM_CONC_SCHEDULER_MAX_WORKERS)
+        MVM_exception_throw_adhoc(tc,
+            "A scheduler must have between 1 and %d workers", MVM_CONC_SCHEDULER_MAX_WORKERS);
+
+    /* Installing the queue for submitted tasks claims the scheduler, so we
+     * can't start it twice. */
+    MVMROOT(tc, scheduler, {
+        injected = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTQueue);
+    });
+    if (MVM_casptr(&(((MVMConcScheduler *)scheduler)->body.injected), NULL, injected) != NULL)
+        MVM_exception_throw_adhoc(tc, "This scheduler has already been started");
+    MVM_gc_write_barrier(tc, &(scheduler->header), &(injected->header));
+
+    /* Set up the pool. */
+    pool = MVM_calloc(1, sizeof(MVMConcSchedulerPool));
+    if ((init_stat = uv_mutex_init(&pool->lock)) < 0)
+        MVM_panic(MVM_exitcode_threads, "Failed to initialize scheduler mutex: %s",
+            uv_strerror(init_stat));
+    if ((init_stat = uv_cond_init(&pool->cond)) < 0)
+        MVM_panic(MVM_exitcode_threads, "Failed to initialize scheduler condition variable: %s",
+            uv_strerror(init_stat));
+    pool->num_workers = (MVMuint32)num_workers;
+    pool->deques      = MVM_calloc(pool->num_workers, sizeof(MVMConcSchedulerDeque));
+    for (i = 0; i < pool->num_workers; i++) {
+        pool->deques[i].top    = 1;
+        pool->deques[i].bottom = 1;
+        pool->deques[i].buffer = alloc_buffer(tc, MVM_CONC_SCHEDULER_INITIAL_TASKS);
+    }
+    MVM_store(&(((MVMConcScheduler *)scheduler)->body.pool), pool);
+
+    /* Start the workers. Nothing between giving a worker's thread context the
+     * scheduler and starting it running can trigger GC, after which the GC
+     * will update that reference. */
+    MVMROOT(tc, scheduler, {
+        for (i = 0; i < pool->num_workers; i++) {
+            MVMObject *thread = MVM_thread_new(tc, NULL, 1);
+            MVMThreadContext *child_tc = ((MVMThread *)thread)->body.tc;
+            child_tc->scheduler        = scheduler;
+            child_tc->scheduler_worker = i;
+            MVM_thread_run_native(tc, thread, worker_loop, pool);
+        }
+    });
+}
+
+/* Submits a task (something invokable with no arguments) to a scheduler. If
+ * we're one of its workers, it goes on our own deque; otherwise, it goes on
+ * the queue of submitted tasks. */
+void MVM_conc_scheduler_submit(MVMThreadContext *tc, MVMObject *scheduler, MVMObject *task) {
+    MVMConcSchedulerBody *body = get_body(tc, scheduler, "schedulersubmit");
+    MVMConcSchedulerPool *pool = body->pool;
+    if (!pool)
+        MVM_exception_throw_adhoc(tc, "Cannot submit a task to a scheduler that was not started");
+    if (MVM_is_null(tc, task))
+        MVM_exception_throw_adhoc(tc, "Cannot submit a null task to a scheduler");
+    if (STABLE(task)->invoke == MVM_6model_invoke_default && !STABLE(task)->invocation_spec)
+        MVM_exception_throw_adhoc(tc,
+            "Cannot submit a task that cannot be invoked (REPR: %s; %s) to a scheduler",
+            REPR(task)->name, STABLE(task)->debug_name);
+
+    if (tc->scheduler == scheduler) {
+        MVM_gc_write_barrier(tc, &(scheduler->header), &(task->header));
+        deque_push(tc, &(pool->deques[tc->scheduler_worker]), task);
+    }
+    else {
+        MVM_repr_push_o(tc, body->injected, task);
+    }
+    wake_worker(tc, pool);
+}
+
+/* Gets an integer array of how many tasks are waiting in a scheduler: the
+ * number submitted from other threads first, then the number in each of the
+ * worker deques. The numbers are only a snapshot. */
+MVMObject * MVM_conc_scheduler_depths(MVMThreadContext *tc, MVMObject *scheduler) {
+    MVMObject *result;
+    MVMuint32  i;
+    get_body(tc, scheduler, "schedulerdepths");
+    MVMROOT(tc, scheduler, {
+        result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIntArray);
+    });
+    if (((MVMConcScheduler *)scheduler)->body.pool) {
+        MVMConcSchedulerBody *body = (MVMConcSchedulerBody *)OBJECT_BODY(scheduler);
+        MVM_repr_push_i(tc, result, MVM_repr_elems(tc, body->injected));
+        for (i = 0; i < body->pool->num_workers; i++) {
+            MVMConcSchedulerDeque *deque = &(body->pool->deques[i]);
+            AO_t top    = MVM_load(&deque->top);
+            AO_t bottom = MVM_load(&deque->bottom);
+            MVM_repr_push_i(tc, result, top < bottom ? (MVMint64)(bottom - top) : 0);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+/* Number of task slots in a worker's deque buffer when it is first made; it
+ * doubles whenever it fills up. */
+#define MVM_CONC_SCHEDULER_INITIAL_TASKS 64
+
+/* Most worker threads a scheduler may be started with. */
+#define MVM_CONC_SCHEDULER_MAX_WORKERS 1024
+
+/* Circular buffer of tasks in a worker's deque. */
+struct MVMConcSchedulerBuffer {
+    /* Number of task slots minus one; the number of slots is a power of 2. */
+    AO_t mask;
+
+    /* The task slots. */
+    MVMObject *tasks[1];
+};
+
+/* A Chase-Lev work-stealing deque, one per worker. The owning worker pushes
+ * and takes tasks at the bottom without any atomic read-modify-write except
+ * when racing thieves for the last task; other workers steal from the top
+ * with a CAS. Buffers replaced when growing are freed at the next GC
+ * safepoint, since thieves may still be reading them until then. The live
+ * tasks are those from top up to (but not including) bottom. */
+struct MVMConcSchedulerDeque {
+    AO_t                    top;
+    AO_t                    bottom;
+    MVMConcSchedulerBuffer *buffer;
+};
+
+/* The worker pool, allocated when the scheduler is started. This can't live
+ * in the object body directly as the mutex and cond var are sensitive to
+ * being moved, and workers use it without the scheduler object in hand. */
+struct MVMConcSchedulerPool {
+    /* The per-worker deques. */
+    MVMuint32              num_workers;
+    MVMConcSchedulerDeque *deques;
+
+    /* Number of workers parked waiting for tasks. Submitters only need to
+     * touch the lock and cond var when this is non-zero. */
+    AO_t        sleepers;
+    uv_mutex_t  lock;
+    uv_cond_t   cond;
+};
+
+/* Representation used for a work-stealing task scheduler. */
+struct MVMConcSchedulerBody {
+    /* Queue of tasks submitted by threads that are not its workers. */
+    MVMObject *injected;
+
+    /* The worker pool; NULL until the scheduler is started. */
+    MVMConcSchedulerPool *pool;
+};
+struct MVMConcScheduler {
+    MVMObject common;
+    MVMConcSchedulerBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcScheduler_initialize(MVMThreadContext *tc);
+
+/* Operations on schedulers. */
+void MVM_conc_scheduler_start(MVMThreadContext *tc, MVMObject *scheduler, MVMint64 num_workers);
+void MVM_conc_scheduler_submit(MVMThreadContext *tc, MVMObject *scheduler, MVMObject *task);
+MVMObject * MVM_conc_scheduler_depths(MVMThreadContext *tc, MVMObject *scheduler);
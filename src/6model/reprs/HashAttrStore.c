@@ -21,33 +21,32 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMHashAttrStoreBody *src_body  = (MVMHashAttrStoreBody *)src;
     MVMHashAttrStoreBody *dest_body = (MVMHashAttrStoreBody *)dest;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
-
-    /* NOTE: if we really wanted to, we could avoid rehashing... */
-    HASH_ITER(hash_handle, src_body->hash_head, current, tmp, bucket_tmp) {
-        MVMHashEntry *new_entry = MVM_malloc(sizeof(MVMHashEntry));
-        MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, current->value);
-        MVM_HASH_BIND(tc, dest_body->hash_head, MVM_HASH_KEY(current), new_entry);
+    MVMStrHashTable *hash = &(src_body->hashtable);
+    MVMuint32 i;
+
+    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+        MVMStrHashEntry *new_entry = MVM_str_hash_lvalue_fetch(tc, &(dest_body->hashtable),
+            hash->entries[i].key);
+        MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, hash->entries[i].value);
     }
 }
 
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
+    MVMStrHashTable *hash = &(body->hashtable);
+    MVMuint32 i;
 
-    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
-        MVM_gc_worklist_add(tc, worklist, &current->hash_handle.key);
-        MVM_gc_worklist_add(tc, worklist, &current->value);
+    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+        MVM_gc_worklist_add(tc, worklist, &(hash->entries[i].key));
+        MVM_gc_worklist_add(tc, worklist, &(hash->entries[i].value));
     }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMHashAttrStore *h = (MVMHashAttrStore *)obj;
-    MVM_HASH_DESTROY(hash_handle, MVMHashEntry, h->body.hash_head);
+    MVM_str_hash_demolish(tc, &(h->body.hashtable));
 }
 
 static void get_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
@@ -55,8 +54,9 @@ static void get_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
         MVMRegister *result_reg, MVMuint16 kind) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
     if (kind == MVM_reg_obj) {
-        MVMHashEntry *entry;
-        MVM_HASH_GET(tc, body->hash_head, name, entry);
+        MVMStrHashEntry *entry;
+        MVM_str_hash_check_key(tc, (MVMObject *)name);
+        entry = MVM_str_hash_fetch(tc, &(body->hashtable), name);
         result_reg->o = entry != NULL ? entry->value : tc->instance->VMNull;
     }
     else {
@@ -70,17 +70,12 @@ static void bind_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
         MVMRegister value_reg, MVMuint16 kind) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
     if (kind == MVM_reg_obj) {
-        MVMHashEntry *entry;
-        MVM_HASH_GET(tc, body->hash_head, name, entry);
-        if (!entry) {
-            entry = MVM_malloc(sizeof(MVMHashEntry));
-            MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
-            MVM_HASH_BIND(tc, body->hash_head, name, entry);
+        MVMStrHashEntry *entry;
+        MVM_str_hash_check_key(tc, (MVMObject *)name);
+        entry = MVM_str_hash_lvalue_fetch(tc, &(body->hashtable), name);
+        if (!entry->value)
             MVM_gc_write_barrier(tc, &(root->header), &(name->common.header));
-        }
-        else {
-            MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
-        }
+        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
     }
     else {
         MVM_exception_throw_adhoc(tc,
@@ -90,9 +85,8 @@ static void bind_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
 
 static MVMint64 is_attribute_initialized(MVMThreadContext *tc, MVMSTable *st, void *data, MVMObject *class_handle, MVMString *name, MVMint64 hint) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
-    MVMHashEntry *entry;
-    MVM_HASH_GET(tc, body->hash_head, name, entry);
-    return entry != NULL;
+    MVM_str_hash_check_key(tc, (MVMObject *)name);
+    return MVM_str_hash_fetch(tc, &(body->hashtable), name) != NULL;
 }
 
 static MVMint64 hint_for(MVMThreadContext *tc, MVMSTable *st, MVMObject *class_handle, MVMString *name) {
@@ -139,7 +133,8 @@ static const MVMREPROps HashAttrStore_this_repr = {
         get_attribute,
         bind_attribute,
         hint_for,
-        is_attribute_initialized
+        is_attribute_initialized,
+        MVM_REPR_DEFAULT_ATTRIBUTE_AS_ATOMIC
     },   /* attr_funcs */
     MVM_REPR_DEFAULT_BOX_FUNCS,
     MVM_REPR_DEFAULT_POS_FUNCS,
@@ -32,15 +32,7 @@ static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
     MVMString      *name  = (MVMString *)key;
     MVMContextBody *body  = (MVMContextBody *)data;
     MVMFrame       *frame = body->context;
-    MVMLexicalRegistry *lexical_names = frame->static_info->body.lexical_names, *entry;
-    if (!lexical_names) {
-        char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-        char *waste[] = { c_name, NULL };
-        MVM_exception_throw_adhoc_free(tc, waste,
-            "Lexical with name '%s' does not exist in this frame",
-                c_name);
-    }
-    MVM_HASH_GET(tc, lexical_names, name, entry);
+    MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, frame->static_info, name);
     if (!entry) {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
@@ -48,34 +40,25 @@ static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
             "Lexical with name '%s' does not exist in this frame",
                 c_name);
     }
-    if (frame->static_info->body.lexical_types[entry->value] != kind) {
+    if (frame->static_info->body.lexical_types[entry->index] != kind) {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
         MVM_exception_throw_adhoc_free(tc, waste,
             "Lexical with name '%s' has a different type in this frame",
                 c_name);
     }
-    *result = frame->env[entry->value];
+    *result = frame->env[entry->index];
     if (kind == MVM_reg_obj && !result->o)
-        result->o = MVM_frame_vivify_lexical(tc, frame, entry->value);
+        result->o = MVM_frame_vivify_lexical(tc, frame, entry->index);
 }
 
 static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key, MVMRegister value, MVMuint16 kind) {
     MVMString      *name  = (MVMString *)key;
     MVMContextBody *body  = (MVMContextBody *)data;
     MVMFrame       *frame = body->context;
-    MVMLexicalRegistry *lexical_names = frame->static_info->body.lexical_names, *entry;
+    MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, frame->static_info, name);
     MVMuint16 got_kind;
 
-    if (!lexical_names) {
-        char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-        char *waste[] = { c_name, NULL };
-        MVM_exception_throw_adhoc_free(tc, waste,
-            "Lexical with name '%s' does not exist in this frame",
-                c_name);
-    }
-
-    MVM_HASH_GET(tc, lexical_names, name, entry);
     if (!entry) {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
@@ -84,7 +67,7 @@ static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
                 c_name);
     }
 
-    got_kind = frame->static_info->body.lexical_types[entry->value];
+    got_kind = frame->static_info->body.lexical_types[entry->index];
     if (got_kind != kind) {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
@@ -94,29 +77,24 @@ static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
     }
 
     if (got_kind == MVM_reg_obj || got_kind == MVM_reg_str) {
-        MVM_ASSIGN_REF(tc, &(frame->header), frame->env[entry->value].o, value.o);
+        MVM_ASSIGN_REF(tc, &(frame->header), frame->env[entry->index].o, value.o);
     }
     else {
-        frame->env[entry->value] = value;
+        frame->env[entry->index] = value;
     }
 }
 
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMContextBody *body  = (MVMContextBody *)data;
     MVMFrame       *frame = body->context;
-    MVMLexicalRegistry *lexical_names = frame->static_info->body.lexical_names;
-    return (MVMuint64) HASH_CNT(hash_handle, lexical_names);
+    return (MVMuint64) MVM_str_hash_count(&(frame->static_info->body.lexical_names));
 }
 
 static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key) {
     MVMContextBody *body = (MVMContextBody *)data;
     MVMFrame *frame = body->context;
-    MVMLexicalRegistry *lexical_names = frame->static_info->body.lexical_names, *entry;
     MVMString *name = (MVMString *)key;
-    if (!lexical_names)
-        return 0;
-    MVM_HASH_GET(tc, lexical_names, name, entry);
-    return entry ? 1 : 0;
+    return MVM_static_frame_lexical(tc, frame->static_info, name) ? 1 : 0;
 }
 
 static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key) {
@@ -27,16 +27,13 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMHashBody *src_body  = (MVMHashBody *)src;
     MVMHashBody *dest_body = (MVMHashBody *)dest;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
+    MVMStrHashTable *hash  = &(src_body->hashtable);
+    MVMuint32 i;
 
-    /* NOTE: if we really wanted to, we could avoid rehashing... */
-    HASH_ITER(hash_handle, src_body->hash_head, current, tmp, bucket_tmp) {
-        MVMHashEntry *new_entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVMString *key = MVM_HASH_KEY(current);
-        MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, current->value);
-        MVM_HASH_BIND(tc, dest_body->hash_head, key, new_entry);
+    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+        MVMString *key = hash->entries[i].key;
+        MVMStrHashEntry *new_entry = MVM_str_hash_lvalue_fetch(tc, &(dest_body->hashtable), key);
+        MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, hash->entries[i].value);
         MVM_gc_write_barrier(tc, &(dest_root->header), &(key->common.header));
     }
 }
@@ -44,35 +41,26 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
+    MVMStrHashTable *hash = &(body->hashtable);
+    MVMuint32 i;
 
-    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
-        MVM_gc_worklist_add(tc, worklist, &current->hash_handle.key);
-        MVM_gc_worklist_add(tc, worklist, &current->value);
+    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+        MVM_gc_worklist_add(tc, worklist, &(hash->entries[i].key));
+        MVM_gc_worklist_add(tc, worklist, &(hash->entries[i].value));
     }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMHash *h = (MVMHash *)obj;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
-    HASH_ITER(hash_handle, h->body.hash_head, current, tmp, bucket_tmp) {
-        if (current != h->body.hash_head)
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), current);
-    }
-    tmp = h->body.hash_head;
-    HASH_CLEAR(hash_handle, h->body.hash_head);
-    if (tmp)
-        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), tmp);
+    MVM_str_hash_demolish(tc, &(h->body.hashtable));
 }
 
 static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *entry;
+    MVMStrHashEntry *entry;
     MVMString *key = get_string_key(tc, key_obj);
-    MVM_HASH_GET(tc, body->hash_head, key, entry);
+    entry = MVM_str_hash_fetch(tc, &(body->hashtable), key);
     if (kind == MVM_reg_obj)
         result->o = entry != NULL ? entry->value : tc->instance->VMNull;
     else
@@ -82,50 +70,35 @@ static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
 
 static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *entry;
+    MVMStrHashEntry *entry;
 
     MVMString *key = get_string_key(tc, key_obj);
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc,
             "MVMHash representation does not support native type storage");
 
-    /* first check whether we can must update the old entry. */
-    MVM_HASH_GET(tc, body->hash_head, key, entry);
-    if (!entry) {
-        entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-        MVM_HASH_BIND(tc, body->hash_head, key, entry);
+    /* Either finds the existing entry or adds one with a NULL value. */
+    entry = MVM_str_hash_lvalue_fetch(tc, &(body->hashtable), key);
+    if (!entry->value)
         MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
-    }
-    else {
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-    }
+    MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
 }
 
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMHashBody *body = (MVMHashBody *)data;
-    return HASH_CNT(hash_handle, body->hash_head);
+    return MVM_str_hash_count(&(body->hashtable));
 }
 
 static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
     MVMHashBody *body = (MVMHashBody *)data;
     MVMString *key = get_string_key(tc, key_obj);
-    MVMHashEntry *entry;
-    MVM_HASH_GET(tc, body->hash_head, key, entry);
-    return entry != NULL;
+    return MVM_str_hash_fetch(tc, &(body->hashtable), key) != NULL;
 }
 
 static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
     MVMHashBody *body = (MVMHashBody *)data;
     MVMString *key = get_string_key(tc, key_obj);
-    MVMHashEntry *old_entry;
-    MVM_HASH_GET(tc, body->hash_head, key, old_entry);
-    if (old_entry) {
-        HASH_DELETE(hash_handle, body->hash_head, old_entry);
-        MVM_fixed_size_free(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry), old_entry);
-    }
+    MVM_str_hash_delete(tc, &(body->hashtable), key);
 }
 
 static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
@@ -166,23 +139,20 @@ static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, vo
     for (i = 0; i < elems; i++) {
         MVMString *key = MVM_serialization_read_str(tc, reader);
         MVMObject *value = MVM_serialization_read_ref(tc, reader);
-        MVMHashEntry *entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
+        MVMStrHashEntry *entry = MVM_str_hash_lvalue_fetch(tc, &(body->hashtable), key);
         MVM_ASSIGN_REF(tc, &(root->header), entry->value, value);
-        MVM_HASH_BIND(tc, body->hash_head, key, entry);
     }
 }
 
 /* Serialize the representation. */
 static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *current, *tmp;
-    unsigned bucket_tmp;
-    MVM_serialization_write_int(tc, writer, HASH_CNT(hash_handle, body->hash_head));
-    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
-        MVMString *key = MVM_HASH_KEY(current);
-        MVM_serialization_write_str(tc, writer, key);
-        MVM_serialization_write_ref(tc, writer, current->value);
+    MVMStrHashTable *hash = &(body->hashtable);
+    MVMuint32 i;
+    MVM_serialization_write_int(tc, writer, MVM_str_hash_count(hash));
+    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+        MVM_serialization_write_str(tc, writer, hash->entries[i].key);
+        MVM_serialization_write_ref(tc, writer, hash->entries[i].value);
     }
 }
 
@@ -213,7 +183,7 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMHashBody *body = (MVMHashBody *)data;
 
-    return sizeof(MVMHashEntry) * HASH_CNT(hash_handle, body->hash_head);
+    return MVM_STR_HASH_ALLOC_SIZE(body->hashtable.alloc_entries);
 }
 
 /* Initializes the representation. */
@@ -1,16 +1,8 @@
 /* Representation used by VM-level hashes. */
 
-struct MVMHashEntry {
-    /* value object */
-    MVMObject *value;
-
-    /* the uthash hash handle inline struct, including the key. */
-    UT_hash_handle hash_handle;
-};
-
 struct MVMHashBody {
-    /* uthash updates this pointer directly. */
-    MVMHashEntry *hash_head;
+    /* The keys and values; see core/str_hash_table.h. */
+    MVMStrHashTable hashtable;
 };
 struct MVMHash {
     MVMObject common;
@@ -104,15 +104,16 @@ static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *da
                 MVM_exception_throw_adhoc(tc, "Wrong register kind in iteration");
             }
             return;
-        case MVM_ITER_MODE_HASH:
-            body->hash_state.curr = body->hash_state.next;
-            if (!body->hash_state.curr)
+        case MVM_ITER_MODE_HASH: {
+            MVMStrHashTable *hash = &(((MVMHash *)target)->body.hashtable);
+            MVMuint32 pos = MVM_str_hash_next(hash, (MVMuint32)body->hash_state.next);
+            if (pos >= hash->num_entries)
                 MVM_exception_throw_adhoc(tc, "Iteration past end of iterator");
-            body->hash_state.next = HASH_ITER_NEXT_ITEM(
-                &(body->hash_state.next->hash_handle),
-                &(body->hash_state.bucket_state));
+            body->hash_state.curr = pos;
+            body->hash_state.next = pos + 1;
             value->o = root;
             return;
+        }
         default:
             MVM_exception_throw_adhoc(tc, "Unknown iteration mode");
     }
@@ -169,7 +170,8 @@ static const MVMREPROps MVMIter_this_repr = {
         MVM_REPR_DEFAULT_BIND_POS_MULTIDIM,
         MVM_REPR_DEFAULT_DIMENSIONS,
         MVM_REPR_DEFAULT_SET_DIMENSIONS,
-        get_elem_storage_spec
+        get_elem_storage_spec,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     MVM_REPR_DEFAULT_ELEMS,
@@ -213,15 +215,14 @@ MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target) {
             iterator = (MVMIter *)MVM_repr_alloc_init(tc,
                 MVM_hll_current(tc)->hash_iterator_type);
             iterator->body.mode = MVM_ITER_MODE_HASH;
-            iterator->body.hash_state.bucket_state = 0;
-            iterator->body.hash_state.curr         = NULL;
-            iterator->body.hash_state.next         = HASH_ITER_FIRST_ITEM(
-                ((MVMHash *)target)->body.hash_head
-                    ? ((MVMHash *)target)->body.hash_head->hash_handle.tbl
-                    : NULL,
-                &(iterator->body.hash_state.bucket_state));
+            iterator->body.hash_state.curr = -1;
+            iterator->body.hash_state.next = 0;
             MVM_ASSIGN_REF(tc, &(iterator->common.header), iterator->body.target, target);
         }
+        else if (REPR(target)->ID == MVM_REPR_ID_ConcHash) {
+            /* Iterate a snapshot, so other threads can't change it under us. */
+            iterator = (MVMIter *)MVM_iter(tc, MVM_conc_hash_snapshot(tc, target));
+        }
         else if (REPR(target)->ID == MVM_REPR_ID_MVMContext) {
             /* Turn the context into a VMHash and then iterate that. */
             MVMHLLConfig *hll = MVM_hll_current(tc);
@@ -316,21 +317,35 @@ MVMint64 MVM_iter_istrue(MVMThreadContext *tc, MVMIter *iter) {
         case MVM_ITER_MODE_ARRAY_STR:
             return iter->body.array_state.index + 1 < iter->body.array_state.limit ? 1 : 0;
             break;
-        case MVM_ITER_MODE_HASH:
-            return iter->body.hash_state.next != NULL ? 1 : 0;
+        case MVM_ITER_MODE_HASH: {
+            MVMStrHashTable *hash = &(((MVMHash *)iter->body.target)->body.hashtable);
+            return MVM_str_hash_next(hash, (MVMuint32)iter->body.hash_state.next) < hash->num_entries ? 1 : 0;
+        }
             break;
         default:
             MVM_exception_throw_adhoc(tc, "Invalid iteration mode used");
     }
 }
 
+/* Gets the entry a hash iterator is currently at. If it was deleted since
+ * we got to it, the key will be NULL. */
+static MVMStrHashEntry * current_hash_entry(MVMThreadContext *tc, MVMIter *iterator) {
+    MVMStrHashTable *hash = &(((MVMHash *)iterator->body.target)->body.hashtable);
+    MVMint64 curr = iterator->body.hash_state.curr;
+    if (curr < 0 || curr >= hash->num_entries)
+        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
+    return &(hash->entries[curr]);
+}
+
 MVMString * MVM_iterkey_s(MVMThreadContext *tc, MVMIter *iterator) {
+    MVMString *key;
     if (REPR(iterator)->ID != MVM_REPR_ID_MVMIter
             || iterator->body.mode != MVM_ITER_MODE_HASH)
         MVM_exception_throw_adhoc(tc, "This is not a hash iterator, it's a %s (%s)", REPR(iterator)->name, STABLE(iterator)->debug_name);
-    if (!iterator->body.hash_state.curr)
-        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-    return MVM_HASH_KEY(iterator->body.hash_state.curr);
+    key = current_hash_entry(tc, iterator)->key;
+    if (!key)
+        MVM_exception_throw_adhoc(tc, "The current item of the hash iterator was deleted");
+    return key;
 }
 
 MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
@@ -347,9 +362,7 @@ MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
         REPR(target)->pos_funcs.at_pos(tc, STABLE(target), target, OBJECT_BODY(target), body->array_state.index, &result, MVM_reg_obj);
     }
     else if (iterator->body.mode == MVM_ITER_MODE_HASH) {
-        if (!iterator->body.hash_state.curr)
-            MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-        result.o = iterator->body.hash_state.curr->value;
+        result.o = current_hash_entry(tc, iterator)->value;
         if (!result.o)
             result.o = tc->instance->VMNull;
     }
@@ -16,8 +16,10 @@ struct MVMIterBody {
     /* next hash item to give or next array index */
     union {
         struct {
-            MVMHashEntry *curr, *next;
-            unsigned      bucket_state;
+            /* Position of the current entry in the hash's entries, or -1
+             * before the first shift, and where to look for the next. */
+            MVMint64 curr;
+            MVMint64 next;
         } hash_state;
         struct {
             MVMint64 index;
@@ -64,17 +64,13 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
         dest_body->lexical_types = lexical_types;
     }
     {
-        MVMLexicalRegistry *current, *tmp;
-        unsigned bucket_tmp;
-
-        /* NOTE: if we really wanted to, we could avoid rehashing... */
-        HASH_ITER(hash_handle, src_body->lexical_names, current, tmp, bucket_tmp) {
-            MVMLexicalRegistry *new_entry = MVM_malloc(sizeof(MVMLexicalRegistry));
-            /* don't need to clone the string */
-            MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->key, current->key);
-            new_entry->value = current->value;
-            MVM_HASH_BIND(tc, dest_body->lexical_names, current->key, new_entry);
-        }
+        MVMStrHashTable *names = &(dest_body->lexical_names);
+        MVMuint32 i;
+
+        /* Copies the table without rehashing; the keys need not be cloned. */
+        MVM_str_hash_copy(tc, names, &(src_body->lexical_names));
+        for (i = MVM_str_hash_next(names, 0); i < names->num_entries; i = MVM_str_hash_next(names, i + 1))
+            MVM_gc_write_barrier(tc, &(dest_root->header), &(names->entries[i].key->common.header));
     }
 
     /* Static environment needs to be copied, and any objects WB'd. */
@@ -116,8 +112,8 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMStaticFrameBody *body = (MVMStaticFrameBody *)data;
-    MVMLexicalRegistry *current, *tmp;
-    unsigned bucket_tmp;
+    MVMStrHashTable *names = &(body->lexical_names);
+    MVMuint32 i;
 
     /* mvmobjects */
     MVM_gc_worklist_add(tc, worklist, &body->cu);
@@ -131,10 +127,11 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
         return;
 
     /* lexical names hash keys */
-    HASH_ITER(hash_handle, body->lexical_names, current, tmp, bucket_tmp) {
-        MVM_gc_worklist_add(tc, worklist, &current->hash_handle.key);
-        MVM_gc_worklist_add(tc, worklist, &current->key);
-    }
+    for (i = MVM_str_hash_next(names, 0); i < names->num_entries; i = MVM_str_hash_next(names, i + 1))
+        MVM_gc_worklist_add(tc, worklist, &names->entries[i].key);
+    if (body->lexical_names_list)
+        for (i = 0; i < body->num_lexicals; i++)
+            MVM_gc_worklist_add(tc, worklist, &body->lexical_names_list[i]->key);
 
     /* static env */
     if (body->static_env) {
@@ -146,6 +143,15 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
                 MVM_gc_worklist_add(tc, worklist, &body->static_env[i].o);
     }
 
+    /* Inline caches. */
+    MVM_inline_cache_mark(tc, &body->inline_cache, worklist);
+    if (body->lexical_lookup_cache) {
+        MVMuint32 i;
+        for (i = 0; i < MVM_LEXICAL_LOOKUP_CACHE_SIZE; i++)
+            if (body->lexical_lookup_cache[i])
+                MVM_gc_worklist_add(tc, worklist, &body->lexical_lookup_cache[i]->name);
+    }
+
     /* Spesh slots. */
     if (body->num_spesh_candidates) {
         MVMint32 i, j;
@@ -161,6 +167,7 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
                 MVM_gc_worklist_add(tc, worklist, &body->spesh_candidates[i].inlines[j].code);
             if (body->spesh_candidates[i].sg)
                 MVM_spesh_graph_mark(tc, body->spesh_candidates[i].sg, worklist);
+            MVM_inline_cache_mark(tc, &body->spesh_candidates[i].inline_cache, worklist);
         }
     }
 }
@@ -186,7 +193,9 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVM_free(body->local_types);
     MVM_free(body->lexical_types);
     MVM_free(body->lexical_names_list);
-    MVM_HASH_DESTROY(hash_handle, MVMLexicalRegistry, body->lexical_names);
+    MVM_str_hash_demolish(tc, &body->lexical_names);
+    MVM_inline_cache_destroy(tc, &body->inline_cache);
+    MVM_frame_lexical_lookup_cache_destroy(tc, sf);
 
     for (i = 0; i < body->num_spesh_candidates; i++)
         MVM_spesh_candidate_destroy(tc, &body->spesh_candidates[i]);
@@ -230,7 +239,9 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
 
         size += sizeof(MVMLexicalRegistry *) * body->num_lexicals;
 
-        size += sizeof(MVMLexicalRegistry) * HASH_CNT(hash_handle, body->lexical_names);
+        size += sizeof(MVMLexicalRegistry) * body->num_lexicals;
+
+        size += MVM_STR_HASH_ALLOC_SIZE(body->lexical_names.alloc_entries);
 
         size += sizeof(MVMFrameHandler) * body->num_handlers;
 
@@ -239,6 +250,11 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
         /*
         size += sizeof(MVMuint8) * body->num_annotations
         */
+        size += sizeof(MVMMethodInlineCacheEntry *) * body->inline_cache.num_entries;
+        if (body->lexical_lookup_cache)
+            size += (sizeof(MVMLexicalLookupCacheEntry *) + sizeof(MVMLexicalLookupCacheEntry))
+                * MVM_LEXICAL_LOOKUP_CACHE_SIZE;
+
         size += body->env_size; /* static_env */
         size += body->num_lexicals; /* static_env_flags */
 
@@ -262,6 +278,8 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
 
             size += sizeof(MVMSpeshInline) * cand->num_inlines;
 
+            size += sizeof(MVMMethodInlineCacheEntry *) * cand->inline_cache.num_entries;
+
             size += sizeof(MVMuint16) * (cand->num_locals + cand->num_lexicals);
 
             /* XXX probably don't need to measure the bytecode size here,
@@ -298,8 +316,8 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
 
 static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
     MVMStaticFrameBody *body = (MVMStaticFrameBody *)data;
-    MVMLexicalRegistry *current, *tmp;
-    unsigned bucket_tmp;
+    MVMStrHashTable *names = &(body->lexical_names);
+    MVMuint32 i;
 
     MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
         (MVMCollectable *)body->cu, "Compilation Unit");
@@ -317,10 +335,9 @@ static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTa
         return;
 
     /* lexical names hash keys */
-    HASH_ITER(hash_handle, body->lexical_names, current, tmp, bucket_tmp) {
+    for (i = MVM_str_hash_next(names, 0); i < names->num_entries; i = MVM_str_hash_next(names, i + 1))
         MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-            (MVMCollectable *)current->key, "Lexical name");
-    }
+            (MVMCollectable *)names->entries[i].key, "Lexical name");
 
     /* static env */
     if (body->static_env) {
@@ -13,8 +13,8 @@ struct MVMStaticFrameBody {
     /* The list of lexical types. */
     MVMuint16 *lexical_types;
 
-    /* Lexicals name map. */
-    MVMLexicalRegistry *lexical_names;
+    /* Lexicals name map, from name to index, and list in index order. */
+    MVMStrHashTable lexical_names;
     MVMLexicalRegistry **lexical_names_list;
 
     /* Defaults for lexicals upon new frame creation. */
@@ -113,6 +113,14 @@ struct MVMStaticFrameBody {
 
     /* Extra profiling/instrumentation state. */
     MVMStaticFrameInstrumentation *instrumentation;
+
+    /* Inline caches for method lookups in the unspecialized bytecode. */
+    MVMInlineCache inline_cache;
+
+    /* Cache of lexical lookups by name starting from frames of this static
+     * frame, indexed by name hash; NULL until the first lookup is cached.
+     * See MVMLexicalLookupCacheEntry. */
+    MVMLexicalLookupCacheEntry **lexical_lookup_cache;
 };
 struct MVMStaticFrame {
     MVMObject common;
@@ -132,3 +140,12 @@ struct MVMStaticFrameInstrumentation {
 
 /* Function for REPR setup. */
 const MVMREPROps * MVMStaticFrame_initialize(MVMThreadContext *tc);
+
+/* Looks up a lexical by name in a static frame, returning the name map entry
+ * (whose index is the lexical's index) or NULL if there is no such lexical. */
+MVM_STATIC_INLINE MVMStrHashEntry * MVM_static_frame_lexical(MVMThreadContext *tc, MVMStaticFrame *sf, MVMString *name) {
+    if (!MVM_str_hash_count(&sf->body.lexical_names))
+        return NULL;
+    MVM_str_hash_check_key(tc, (MVMObject *)name);
+    return MVM_str_hash_fetch(tc, &sf->body.lexical_names, name);
+}
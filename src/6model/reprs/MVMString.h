@@ -61,6 +61,11 @@ struct MVMStringStrand {
 
     /* Number of repetitions. */
     MVMuint32 repetitions;
+
+    /* The grapheme index in the strand string at which this strand begins,
+     * so we can binary search for the strand holding a given index. (This
+     * sits in what would otherwise be padding.) */
+    MVMStringIndex offset;
 };
 
 /* The MVMString, with header and body. */
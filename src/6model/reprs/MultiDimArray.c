@@ -778,7 +778,8 @@ static const MVMREPROps MultiDimArray_this_repr = {
         bind_pos_multidim,
         dimensions,
         set_dimensions,
-        get_elem_storage_spec
+        get_elem_storage_spec,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC
     },
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
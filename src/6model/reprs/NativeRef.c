@@ -302,21 +302,17 @@ MVMObject * MVM_nativeref_lex_s(MVMThreadContext *tc, MVMuint16 outers, MVMuint1
 static MVMObject * lexref_by_name(MVMThreadContext *tc, MVMObject *type, MVMString *name, MVMuint16 kind) {
     MVMFrame *cur_frame = tc->cur_frame;
     while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == kind) {
-                    return lex_ref(tc, type, cur_frame, &cur_frame->env[entry->value], kind);
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
+        MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, cur_frame->static_info, name);
+        if (entry) {
+            if (cur_frame->static_info->body.lexical_types[entry->index] == kind) {
+                return lex_ref(tc, type, cur_frame, &cur_frame->env[entry->index], kind);
+            }
+            else {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+                char *waste[] = { c_name, NULL };
+                MVM_exception_throw_adhoc_free(tc, waste,
+                    "Lexical with name '%s' has wrong type",
+                        c_name);
             }
         }
         cur_frame = cur_frame->outer;
@@ -604,3 +600,29 @@ void MVM_nativeref_write_multidim_s(MVMThreadContext *tc, MVMObject *ref_obj, MV
     MVMNativeRef *ref = (MVMNativeRef *)ref_obj;
     MVM_repr_bind_pos_multidim_s(tc, ref->body.u.multidim.obj, ref->body.u.multidim.indices, value);
 }
+
+/* Gets the address of the 64-bit native integer a reference points to, so
+ * that atomic operations can be performed on it. The address is only valid
+ * until the next GC safepoint. */
+AO_t * MVM_nativeref_as_atomic_i(MVMThreadContext *tc, MVMObject *ref_obj) {
+    MVMNativeRef *ref = (MVMNativeRef *)ref_obj;
+#if MVM_PTR_SIZE < 8
+    MVM_exception_throw_adhoc(tc, "Atomic operations on native integers need a 64-bit platform");
+#else
+    switch (((MVMNativeRefREPRData *)STABLE(ref_obj)->REPR_data)->ref_kind) {
+        case MVM_NATIVEREF_LEX:
+            if (ref->body.u.lex.type != MVM_reg_int64 && ref->body.u.lex.type != MVM_reg_uint64)
+                MVM_exception_throw_adhoc(tc, "Can only do atomic operations on a 64-bit native integer lexical");
+            return (AO_t *)&(ref->body.u.lex.var->i64);
+        case MVM_NATIVEREF_ATTRIBUTE:
+            return MVM_repr_attribute_as_atomic(tc, ref->body.u.attribute.obj,
+                ref->body.u.attribute.class_handle, ref->body.u.attribute.name,
+                MVM_reg_int64);
+        case MVM_NATIVEREF_POSITIONAL:
+            return MVM_repr_pos_as_atomic(tc, ref->body.u.positional.obj,
+                ref->body.u.positional.idx, MVM_reg_int64);
+        default:
+            MVM_exception_throw_adhoc(tc, "Atomic operations are not supported on this kind of native reference");
+    }
+#endif
+}
@@ -422,6 +422,41 @@ static MVMint64 is_attribute_initialized(MVMThreadContext *tc, MVMSTable *st, vo
     return 0;
 }
 
+/* Checks if the attribute in the given slot is a flattened 64-bit native
+ * integer, which is what atomic integer operations can be done on. */
+static MVMint64 is_int64_slot(MVMThreadContext *tc, MVMP6opaqueREPRData *repr_data, MVMint64 slot) {
+    MVMSTable *attr_st = repr_data->flattened_stables[slot];
+    return attr_st && attr_st->REPR->ID == MVM_REPR_ID_P6int &&
+        attr_st->REPR->get_storage_spec(tc, attr_st)->bits == 64;
+}
+
+/* Gets the address of an attribute for doing atomic operations on. */
+static AO_t * attribute_as_atomic(MVMThreadContext *tc, MVMSTable *st, void *data,
+        MVMObject *class_handle, MVMString *name, MVMuint16 kind) {
+    MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
+    MVMint64 slot;
+
+    if (!repr_data)
+        MVM_exception_throw_adhoc(tc, "P6opaque: must compose %s before using attribute_as_atomic", st->debug_name);
+
+    data = MVM_p6opaque_real_data(tc, data);
+    slot = try_get_slot(tc, repr_data, class_handle, name);
+    if (slot < 0)
+        no_such_attribute(tc, "do an atomic operation", class_handle, name);
+    if (kind == MVM_reg_obj) {
+        if (repr_data->flattened_stables[slot])
+            invalid_access_kind(tc, "atomic access to", class_handle, name, "object");
+    }
+    else if (kind == MVM_reg_int64) {
+        if (!is_int64_slot(tc, repr_data, slot))
+            invalid_access_kind(tc, "atomic access to", class_handle, name, "int64");
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "P6opaque: invalid kind in atomic attribute access in %s", st->debug_name);
+    }
+    return (AO_t *)((char *)data + repr_data->attribute_offsets[slot]);
+}
+
 /* Gets the hint for the given attribute ID. */
 static MVMint64 hint_for(MVMThreadContext *tc, MVMSTable *st, MVMObject *class_key, MVMString *name) {
     MVMint64 slot;
@@ -1283,6 +1318,23 @@ static void osplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     REPR(del)->pos_funcs.splice(tc, STABLE(del), del, OBJECT_BODY(del), target_array, offset, elems);
 }
 
+static AO_t * pos_as_atomic(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMuint16 kind) {
+    MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
+    MVMObject *del;
+    if (repr_data->pos_del_slot == -1)
+        die_no_pos_del(tc, st);
+    data = MVM_p6opaque_real_data(tc, data);
+    del = get_obj_at_offset(data, repr_data->attribute_offsets[repr_data->pos_del_slot]);
+
+    /* The caller will apply the write barrier to us, not to the delegate
+     * that actually holds the element, so apply it to the delegate now as
+     * if a nursery object were being stored. */
+    if (kind == MVM_reg_obj && (del->header.flags & MVM_CF_SECOND_GEN))
+        MVM_gc_write_barrier_hit(tc, &(del->header));
+
+    return REPR(del)->pos_funcs.pos_as_atomic(tc, STABLE(del), del, OBJECT_BODY(del), index, kind);
+}
+
 static void die_no_ass_del(MVMThreadContext *tc, MVMSTable *st) {
     MVM_exception_throw_adhoc(tc, "This type (%s) does not support associative operations", st->debug_name);
 }
@@ -1343,6 +1395,43 @@ static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
     }
 }
 
+/* Gets the offset within the body of objects of the given type of a 64-bit
+ * native integer attribute, or -1 if there's no such attribute. Used by spesh
+ * to turn atomic operations on a reference to the attribute into ones on the
+ * object itself. */
+MVMint64 MVM_p6opaque_int64_attr_offset(MVMThreadContext *tc, MVMObject *type,
+        MVMObject *class_handle, MVMString *name) {
+    MVMP6opaqueREPRData *repr_data;
+    MVMint64 slot;
+    if (REPR(type)->ID != MVM_REPR_ID_P6opaque)
+        return -1;
+    repr_data = (MVMP6opaqueREPRData *)STABLE(type)->REPR_data;
+    if (!repr_data)
+        return -1;
+    slot = try_get_slot(tc, repr_data, class_handle, name);
+    return slot >= 0 && is_int64_slot(tc, repr_data, slot)
+        ? repr_data->attribute_offsets[slot]
+        : -1;
+}
+
+/* The atomic object ops on an attribute at a known offset within the body,
+ * which spesh turns the attribute forms into; used by the interpreter and
+ * the JIT. */
+MVMObject * MVM_p6opaque_atomic_cas_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset,
+        MVMObject *expected, MVMObject *value) {
+    char *data = MVM_p6opaque_real_data(tc, OBJECT_BODY(obj));
+    return MVM_repr_atomic_cas_o(tc, obj, (AO_t *)(data + offset), expected, value);
+}
+MVMObject * MVM_p6opaque_atomic_load_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset) {
+    char *data = MVM_p6opaque_real_data(tc, OBJECT_BODY(obj));
+    return MVM_repr_atomic_load_o(tc, (AO_t *)(data + offset));
+}
+void MVM_p6opaque_atomic_bind_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset,
+        MVMObject *value) {
+    char *data = MVM_p6opaque_real_data(tc, OBJECT_BODY(obj));
+    MVM_repr_atomic_bind_o(tc, obj, (AO_t *)(data + offset), value);
+}
+
 /* Bytecode specialization for this REPR. */
 static MVMString * spesh_attr_name(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshOperand o, MVMint32 indirect) {
     if (indirect) {
@@ -1547,6 +1636,43 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
         }
         break;
     }
+    case MVM_OP_casattr_o:
+    case MVM_OP_atomicloadattr_o: {
+        MVMSpeshFacts *ch_facts = MVM_spesh_get_and_use_facts(tc, g, ins->operands[2]);
+        MVMString     *name     = spesh_attr_name(tc, g, ins->operands[3], 1);
+        if (name && ch_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE && ch_facts->type) {
+            MVMint64 slot = try_get_slot(tc, repr_data, ch_facts->type, name);
+            if (slot >= 0 && !repr_data->mi && !repr_data->flattened_stables[slot]) {
+                MVM_spesh_get_facts(tc, g, ins->operands[3])->usages--;
+                MVM_spesh_get_facts(tc, g, ins->operands[2])->usages--;
+                ins->operands[2].lit_i16 = repr_data->attribute_offsets[slot];
+                if (opcode == MVM_OP_casattr_o) {
+                    ins->info = MVM_op_get_op(MVM_OP_sp_p6ocas_o);
+                    ins->operands[3] = ins->operands[4];
+                    ins->operands[4] = ins->operands[5];
+                }
+                else {
+                    ins->info = MVM_op_get_op(MVM_OP_sp_p6oatomicload_o);
+                }
+            }
+        }
+        break;
+    }
+    case MVM_OP_atomicbindattr_o: {
+        MVMSpeshFacts *ch_facts = MVM_spesh_get_and_use_facts(tc, g, ins->operands[1]);
+        MVMString     *name     = spesh_attr_name(tc, g, ins->operands[2], 1);
+        if (name && ch_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE && ch_facts->type) {
+            MVMint64 slot = try_get_slot(tc, repr_data, ch_facts->type, name);
+            if (slot >= 0 && !repr_data->mi && !repr_data->flattened_stables[slot]) {
+                MVM_spesh_get_facts(tc, g, ins->operands[2])->usages--;
+                MVM_spesh_get_facts(tc, g, ins->operands[1])->usages--;
+                ins->info = MVM_op_get_op(MVM_OP_sp_p6oatomicbind_o);
+                ins->operands[1].lit_i16 = repr_data->attribute_offsets[slot];
+                ins->operands[2] = ins->operands[3];
+            }
+        }
+        break;
+    }
     }
 }
 
@@ -1564,7 +1690,8 @@ static const MVMREPROps P6opaque_this_repr = {
         get_attribute,
         bind_attribute,
         hint_for,
-        is_attribute_initialized
+        is_attribute_initialized,
+        attribute_as_atomic
     },    /* attr_funcs */
     {
         set_int,
@@ -1586,7 +1713,12 @@ static const MVMREPROps P6opaque_this_repr = {
         unshift,
         shift,
         osplice,
-        NULL
+        NULL, /* at_pos_multidim */
+        NULL, /* bind_pos_multidim */
+        NULL, /* dimensions */
+        NULL, /* set_dimensions */
+        NULL, /* get_elem_storage_spec */
+        pos_as_atomic
     },    /* pos_funcs */
     {
         at_key,
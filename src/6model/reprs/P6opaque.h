@@ -97,6 +97,13 @@ struct MVMP6opaqueREPRData {
 
 /* Function for REPR setup. */
 const MVMREPROps * MVMP6opaque_initialize(MVMThreadContext *tc);
+MVMint64 MVM_p6opaque_int64_attr_offset(MVMThreadContext *tc, MVMObject *type,
+    MVMObject *class_handle, MVMString *name);
+MVMObject * MVM_p6opaque_atomic_cas_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset,
+    MVMObject *expected, MVMObject *value);
+MVMObject * MVM_p6opaque_atomic_load_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset);
+void MVM_p6opaque_atomic_bind_o(MVMThreadContext *tc, MVMObject *obj, MVMuint16 offset,
+    MVMObject *value);
 
 /* If an object gets mixed in to, we need to be sure we look at its real body,
  * which may have been moved to hang off the specified pointer.
@@ -0,0 +1,315 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps StringBuilder_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &StringBuilder_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStringBuilder);
+    });
+
+    return st->WHAT;
+}
+
+/* Width in bytes of a grapheme in the given buffer storage type. */
+MVM_STATIC_INLINE size_t grapheme_size(MVMuint16 storage_type) {
+    return storage_type == MVM_STRING_GRAPHEME_32 ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8);
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMStringBuilderBody *src_body  = (MVMStringBuilderBody *)src;
+    MVMStringBuilderBody *dest_body = (MVMStringBuilderBody *)dest;
+    *dest_body = *src_body;
+    if (src_body->capacity) {
+        size_t size = src_body->capacity * grapheme_size(src_body->storage_type);
+        dest_body->buffer.any = MVM_malloc(size);
+        memcpy(dest_body->buffer.any, src_body->buffer.any, size);
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMStringBuilder *sb = (MVMStringBuilder *)obj;
+    MVM_free(sb->body.buffer.any);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStringBuilder);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    return body->capacity * grapheme_size(body->storage_type);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc) {
+    return &StringBuilder_this_repr;
+}
+
+static const MVMREPROps StringBuilder_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "StringBuilder", /* name */
+    MVM_REPR_ID_StringBuilder,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Gets the body of a string builder, throwing if the object isn't one. */
+static MVMStringBuilderBody * get_body(MVMThreadContext *tc, MVMObject *sb, const char *op) {
+    if (REPR(sb)->ID != MVM_REPR_ID_StringBuilder || !IS_CONCRETE(sb))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the StringBuilder representation",
+            op);
+    return &(((MVMStringBuilder *)sb)->body);
+}
+
+/* Makes sure there's space for another so many graphemes, growing the buffer
+ * by doubling so appends are amortized O(1). An empty builder has no buffer,
+ * and always starts over with 8-bit storage. */
+static void ensure_space(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMuint64 extra) {
+    MVMuint64 needed = (MVMuint64)body->num_graphs + extra;
+    MVMuint64 capacity;
+    if (needed <= body->capacity)
+        return;
+    if (needed > 0xFFFFFFFF)
+        MVM_exception_throw_adhoc(tc,
+            "Can't append to string builder, required number of graphemes %"PRIu64" > max allowed of %u",
+             needed, 0xFFFFFFFF);
+    if (body->capacity == 0)
+        body->storage_type = MVM_STRING_GRAPHEME_8;
+    capacity = (MVMuint64)body->capacity * 2;
+    if (capacity < needed)
+        capacity = needed;
+    if (capacity < 16)
+        capacity = 16;
+    if (capacity > 0xFFFFFFFF)
+        capacity = 0xFFFFFFFF;
+    body->buffer.any = MVM_realloc(body->buffer.any, capacity * grapheme_size(body->storage_type));
+    body->capacity   = (MVMuint32)capacity;
+}
+
+/* Moves the buffer from 8-bit to 32-bit storage. */
+static void widen(MVMThreadContext *tc, MVMStringBuilderBody *body) {
+    MVMGrapheme8  *old_buf = body->buffer.blob_8;
+    MVMGrapheme32 *new_buf = MVM_malloc(body->capacity * sizeof(MVMGrapheme32));
+    MVMuint32      i;
+    for (i = 0; i < body->num_graphs; i++)
+        new_buf[i] = old_buf[i];
+    MVM_free(old_buf);
+    body->buffer.blob_32 = new_buf;
+    body->storage_type   = MVM_STRING_GRAPHEME_32;
+}
+
+/* Notes if appending something starting with the given grapheme could mean
+ * the result is no longer in NFG. */
+static void check_join(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMGrapheme32 first) {
+    if (body->num_graphs && !body->needs_nfg) {
+        MVMGrapheme32 last = body->storage_type == MVM_STRING_GRAPHEME_32
+            ? body->buffer.blob_32[body->num_graphs - 1]
+            : body->buffer.blob_8[body->num_graphs - 1];
+        if (!MVM_nfg_is_concat_stable_graphemes(tc, last, first))
+            body->needs_nfg = 1;
+    }
+}
+
+/* Appends graphemes from start up to end of a flat string. Space must have
+ * been ensured already. */
+static void append_flat(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMString *s,
+        MVMStringIndex start, MVMStringIndex end) {
+    MVMStringIndex i;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+            MVMGrapheme8 *out = body->buffer.blob_8 + body->num_graphs;
+            for (i = start; i < end; i++) {
+                MVMGrapheme32 g = s->body.storage.blob_32[i];
+                if (g < -128 || g > 127)
+                    break;
+                *out++ = g;
+            }
+            body->num_graphs += i - start;
+            if (i == end)
+                return;
+            widen(tc, body);
+            start = i;
+        }
+        memcpy(body->buffer.blob_32 + body->num_graphs, s->body.storage.blob_32 + start,
+            (end - start) * sizeof(MVMGrapheme32));
+    }
+    else if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+        memcpy(body->buffer.blob_8 + body->num_graphs, s->body.storage.blob_8 + start,
+            end - start);
+    }
+    else {
+        MVMGrapheme32 *out = body->buffer.blob_32 + body->num_graphs;
+        for (i = start; i < end; i++)
+            *out++ = s->body.storage.blob_8[i];
+    }
+    body->num_graphs += end - start;
+}
+
+/* Appends ASCII characters. */
+static void append_ascii(MVMThreadContext *tc, MVMStringBuilderBody *body, const char *chars, size_t len) {
+    size_t i;
+    if (!len)
+        return;
+    check_join(tc, body, chars[0]);
+    ensure_space(tc, body, len);
+    if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+        memcpy(body->buffer.blob_8 + body->num_graphs, chars, len);
+    }
+    else {
+        for (i = 0; i < len; i++)
+            body->buffer.blob_32[body->num_graphs + i] = chars[i];
+    }
+    body->num_graphs += len;
+}
+
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMObject *sb, MVMString *s) {
+    MVMStringBuilderBody *body = get_body(tc, sb, "strbuilderappend_s");
+    MVMuint32 graphs;
+    MVM_string_check_arg(tc, s, "strbuilderappend_s");
+    graphs = MVM_string_graphs_nocheck(tc, s);
+    if (!graphs)
+        return;
+    check_join(tc, body, MVM_string_get_grapheme_at_nocheck(tc, s, 0));
+    ensure_space(tc, body, graphs);
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *ss = &(s->body.storage.strands[i]);
+            MVMuint32 rep;
+            for (rep = 0; rep <= ss->repetitions; rep++)
+                append_flat(tc, body, ss->blob_string, ss->start, ss->end);
+        }
+    }
+    else {
+        append_flat(tc, body, s, 0, graphs);
+    }
+}
+
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMObject *sb, MVMint64 i) {
+    MVMStringBuilderBody *body = get_body(tc, sb, "strbuilderappend_i");
+    char buffer[MVM_COERCE_BUFFER_SIZE];
+    append_ascii(tc, body, buffer, MVM_coerce_i_buf(tc, i, buffer));
+}
+
+void MVM_string_builder_append_num(MVMThreadContext *tc, MVMObject *sb, MVMnum64 n) {
+    MVMStringBuilderBody *body = get_body(tc, sb, "strbuilderappend_n");
+    char buffer[MVM_COERCE_BUFFER_SIZE];
+    append_ascii(tc, body, buffer, MVM_coerce_n_buf(tc, n, buffer));
+}
+
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *sb, MVMint64 cp) {
+    MVMStringBuilderBody *body = get_body(tc, sb, "strbuilderappendcp");
+    if (cp < 0)
+        MVM_exception_throw_adhoc(tc, "strbuilderappendcp codepoint cannot be negative");
+
+    /* Some codepoints aren't in NFG even on their own (for example, those
+     * with singleton decompositions); checking the codepoint as if it
+     * followed a control character catches those. */
+    if (cp >= MVM_NORMALIZE_FIRST_SIG_NFC && !MVM_nfg_is_concat_stable_graphemes(tc, '\n', cp))
+        body->needs_nfg = 1;
+    else
+        check_join(tc, body, cp);
+
+    ensure_space(tc, body, 1);
+    if (body->storage_type == MVM_STRING_GRAPHEME_8 && cp > 127)
+        widen(tc, body);
+    if (body->storage_type == MVM_STRING_GRAPHEME_8)
+        body->buffer.blob_8[body->num_graphs++] = cp;
+    else
+        body->buffer.blob_32[body->num_graphs++] = cp;
+}
+
+MVMint64 MVM_string_builder_chars(MVMThreadContext *tc, MVMObject *sb) {
+    return get_body(tc, sb, "strbuilderchars")->num_graphs;
+}
+
+/* Turns what has been appended into a string, handing over the buffer rather
+ * than copying it, and leaves the builder empty. */
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMObject *sb) {
+    MVMStringBuilderBody *body = get_body(tc, sb, "strbuilderfinish");
+    MVMString *result;
+    MVMint32   needs_nfg;
+
+    if (!body->num_graphs) {
+        MVM_free(body->buffer.any);
+        body->buffer.any = NULL;
+        body->capacity   = 0;
+        body->needs_nfg  = 0;
+        return tc->instance->str_consts.empty;
+    }
+
+    MVMROOT(tc, sb, {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    body = &(((MVMStringBuilder *)sb)->body);
+
+    /* Give back any space we over-allocated by a good margin; shrinking is
+     * done in place by any sensible realloc. */
+    if (body->capacity - body->num_graphs > body->num_graphs / 4)
+        body->buffer.any = MVM_realloc(body->buffer.any,
+            body->num_graphs * grapheme_size(body->storage_type));
+    result->body.storage_type = body->storage_type;
+    result->body.storage.any  = body->buffer.any;
+    result->body.num_graphs   = body->num_graphs;
+    needs_nfg                 = body->needs_nfg;
+
+    body->buffer.any = NULL;
+    body->num_graphs = 0;
+    body->capacity   = 0;
+    body->needs_nfg  = 0;
+
+    return needs_nfg ? MVM_string_re_nfg(tc, result) : result;
+}
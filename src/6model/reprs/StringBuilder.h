@@ -0,0 +1,37 @@
+/* Representation used for a VM-provided string builder, which accumulates
+ * graphemes in a growable buffer that can become a string without copying. */
+struct MVMStringBuilderBody {
+    /* The graphemes appended so far. */
+    union {
+        MVMGrapheme32 *blob_32;
+        MVMGrapheme8  *blob_8;
+        void          *any;
+    } buffer;
+
+    /* The type of the buffer; we start out with 8-bit storage, and move to
+     * 32-bit storage when we're first given a grapheme that needs it. */
+    MVMuint16 storage_type;
+
+    /* Non-zero if something appended may have combined with what came
+     * before it, meaning the result needs putting back into NFG. */
+    MVMuint16 needs_nfg;
+
+    /* The number of graphemes appended, and how many there's space for. */
+    MVMuint32 num_graphs;
+    MVMuint32 capacity;
+};
+struct MVMStringBuilder {
+    MVMObject common;
+    MVMStringBuilderBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc);
+
+/* Operations on a StringBuilder object. */
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMObject *sb, MVMString *s);
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMObject *sb, MVMint64 i);
+void MVM_string_builder_append_num(MVMThreadContext *tc, MVMObject *sb, MVMnum64 n);
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMObject *sb, MVMint64 cp);
+MVMint64 MVM_string_builder_chars(MVMThreadContext *tc, MVMObject *sb);
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMObject *sb);
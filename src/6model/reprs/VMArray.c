@@ -921,6 +921,38 @@ static void set_dimensions(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
     set_elems(tc, st, root, data, dimensions[0]);
 }
 
+static AO_t * pos_as_atomic(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
+        void *data, MVMint64 index, MVMuint16 kind) {
+    MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
+    MVMArrayBody     *body      = (MVMArrayBody *)data;
+
+    /* Handle negative indexes; unlike at_pos, there's no auto-vivification,
+     * so the element must exist. */
+    if (index < 0)
+        index += body->elems;
+    if (index < 0 || index >= body->elems)
+        MVM_exception_throw_adhoc(tc, "MVMArray: Index out of bounds");
+
+    /* Go by type. */
+    switch (repr_data->slot_type) {
+        case MVM_ARRAY_OBJ:
+            if (kind != MVM_reg_obj)
+                MVM_exception_throw_adhoc(tc, "MVMArray: atomic access expected object register");
+            return (AO_t *)&(body->slots.o[body->start + index]);
+        case MVM_ARRAY_I64:
+            if (kind != MVM_reg_int64)
+                MVM_exception_throw_adhoc(tc, "MVMArray: atomic access expected int register");
+            return (AO_t *)&(body->slots.i64[body->start + index]);
+        case MVM_ARRAY_U64:
+            if (kind != MVM_reg_int64)
+                MVM_exception_throw_adhoc(tc, "MVMArray: atomic access expected int register");
+            return (AO_t *)&(body->slots.u64[body->start + index]);
+        default:
+            MVM_exception_throw_adhoc(tc,
+                "MVMArray: atomic access is only supported on object and 64-bit integer arrays");
+    }
+}
+
 static MVMStorageSpec get_elem_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     MVMStorageSpec spec;
@@ -1294,7 +1326,8 @@ static const MVMREPROps VMArray_this_repr = {
         bind_pos_multidim,
         dimensions,
         set_dimensions,
-        get_elem_storage_spec
+        get_elem_storage_spec,
+        pos_as_atomic
     },    /* pos_funcs */
     MVM_REPR_DEFAULT_ASS_FUNCS,
     elems,
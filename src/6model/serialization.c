@@ -665,6 +665,9 @@ void MVM_serialization_write_ref(MVMThreadContext *tc, MVMSerializationWriter *w
     else if (REPR(ref)->ID == MVM_REPR_ID_Decoder && IS_CONCRETE(ref)) {
         discrim = REFVAR_VM_NULL;
     }
+    else if (REPR(ref)->ID == MVM_REPR_ID_StringBuilder && IS_CONCRETE(ref)) {
+        discrim = REFVAR_VM_NULL;
+    }
     else if (STABLE(ref) == STABLE(tc->instance->boot_types.BOOTInt) && IS_CONCRETE(ref)) {
         discrim = REFVAR_VM_INT;
     }
@@ -2518,6 +2521,10 @@ static void deserialize_stable(MVMThreadContext *tc, MVMSerializationReader *rea
         MVM_free(st->debug_name);
         st->debug_name = NULL;
         st->being_repossessed = 0;
+
+        /* The method cache will be replaced, so inline caches may now be
+         * holding stale methods. */
+        MVM_inline_cache_invalidate(tc);
     }
 
     /* Read the HOW, WHAT and WHO. */
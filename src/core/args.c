@@ -763,24 +763,38 @@ static void flatten_args(MVMThreadContext *tc, MVMArgProcContext *ctx) {
             arg_pos--;
             arg_info.arg = ctx->args[arg_pos];
 
-            if (arg_info.arg.o && REPR(arg_info.arg.o)->ID == MVM_REPR_ID_MVMHash) {
-                MVMHashBody *body = &((MVMHash *)arg_info.arg.o)->body;
-                MVMHashEntry *current, *tmp;
-                unsigned bucket_tmp;
-
-                HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
-                    MVMString *arg_name = MVM_HASH_KEY(current);
-                    if (!seen_name(tc, arg_name, new_args, new_num_pos, new_arg_pos)) {
-                        if (new_arg_pos + 1 >= new_args_size) {
-                            new_args = MVM_realloc(new_args, (new_args_size *= 2) * sizeof(MVMRegister));
+            if (arg_info.arg.o && (REPR(arg_info.arg.o)->ID == MVM_REPR_ID_MVMHash
+                    || REPR(arg_info.arg.o)->ID == MVM_REPR_ID_ConcHash)) {
+                /* A ConcHash is walked one stripe's published table at a
+                 * time, which is a stable snapshot of that stripe; there is
+                 * no allocation in here, so the tables can't be freed. */
+                MVMObject *flat       = arg_info.arg.o;
+                MVMuint32  is_conc    = REPR(flat)->ID == MVM_REPR_ID_ConcHash;
+                MVMuint32  num_tables = is_conc ? MVM_CONC_HASH_STRIPES : 1;
+                MVMuint32  t;
+
+                for (t = 0; t < num_tables; t++) {
+                    MVMStrHashTable *hash = is_conc
+                        ? MVM_conc_hash_stripe_table(tc, flat, t)
+                        : &(((MVMHash *)flat)->body.hashtable);
+                    MVMuint32 i;
+
+                    if (!hash)
+                        continue;
+                    for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1)) {
+                        MVMString *arg_name = hash->entries[i].key;
+                        if (!seen_name(tc, arg_name, new_args, new_num_pos, new_arg_pos)) {
+                            if (new_arg_pos + 1 >= new_args_size) {
+                                new_args = MVM_realloc(new_args, (new_args_size *= 2) * sizeof(MVMRegister));
+                            }
+                            if (new_flag_pos == new_arg_flags_size) {
+                                new_arg_flags = MVM_realloc(new_arg_flags, (new_arg_flags_size *= 2) * sizeof(MVMCallsiteEntry));
+                            }
+
+                            (new_args + new_arg_pos++)->s = arg_name;
+                            (new_args + new_arg_pos++)->o = hash->entries[i].value;
+                            new_arg_flags[new_flag_pos++] = MVM_CALLSITE_ARG_NAMED | MVM_CALLSITE_ARG_OBJ;
                         }
-                        if (new_flag_pos == new_arg_flags_size) {
-                            new_arg_flags = MVM_realloc(new_arg_flags, (new_arg_flags_size *= 2) * sizeof(MVMCallsiteEntry));
-                        }
-
-                        (new_args + new_arg_pos++)->s = arg_name;
-                        (new_args + new_arg_pos++)->o = current->value;
-                        new_arg_flags[new_flag_pos++] = MVM_CALLSITE_ARG_NAMED | MVM_CALLSITE_ARG_OBJ;
                     }
                 }
             }
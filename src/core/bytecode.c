@@ -625,7 +625,7 @@ void MVM_bytecode_finish_frame(MVMThreadContext *tc, MVMCompUnit *cu,
             entry->value = j;
 
             sf->body.lexical_types[j] = read_int16(pos, 6 * j);
-            MVM_HASH_BIND(tc, sf->body.lexical_names, name, entry)
+            MVM_str_hash_lvalue_fetch(tc, &(sf->body.lexical_names), name)->index = j;
         }
         pos += 6 * sf->body.num_lexicals;
     }
@@ -148,9 +148,78 @@ static void flip_return(MVMThreadContext *tc, void *sr_data) {
     r->i64 = r->i64 ? 0 : 1;
 }
 
+/* Pairs of decimal digits, so integers can be formatted two digits at a
+ * time. */
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Number of decimal digits needed for an unsigned integer. */
+static size_t count_digits(MVMuint64 u) {
+    size_t digits = 1;
+    while (1) {
+        if (u < 10)    return digits;
+        if (u < 100)   return digits + 1;
+        if (u < 1000)  return digits + 2;
+        if (u < 10000) return digits + 3;
+        u      /= 10000;
+        digits += 4;
+    }
+}
+
+/* Writes the digits of an unsigned integer backwards from end, which must
+ * have count_digits(u) characters of space before it. */
+static void write_digits(MVMuint64 u, char *end) {
+    while (u >= 100) {
+        size_t pair = (size_t)(u % 100) * 2;
+        u /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if (u >= 10) {
+        *--end = digit_pairs[u * 2 + 1];
+        *--end = digit_pairs[u * 2];
+    }
+    else {
+        *--end = (char)('0' + u);
+    }
+}
+
+/* Formats an integer into the buffer, which needs space for the sign and up
+ * to 20 digits, returning the length. Negating via unsigned arithmetic means
+ * the most negative value is handled too. */
+static size_t format_int(MVMint64 i, char *buffer) {
+    MVMuint64 u   = i < 0 ? (MVMuint64)0 - (MVMuint64)i : (MVMuint64)i;
+    size_t    len = count_digits(u);
+    if (i < 0) {
+        *buffer++ = '-';
+        write_digits(u, buffer + len);
+        return len + 1;
+    }
+    write_digits(u, buffer + len);
+    return len;
+}
+
+/* Formats an integer into the buffer, which must have space for at least
+ * MVM_COERCE_BUFFER_SIZE characters, returning the length. */
+size_t MVM_coerce_i_buf(MVMThreadContext *tc, MVMint64 i, char *buffer) {
+    size_t len = format_int(i, buffer);
+    buffer[len] = '\0';
+    return len;
+}
+
 MVMString * MVM_coerce_i_s(MVMThreadContext *tc, MVMint64 i) {
-    char buffer[64];
-    int len;
+    MVMString *result;
+    MVMuint64  u;
+    size_t     len;
 
     /* See if we can hit the cache. */
     int cache = i >= 0 && i < MVM_INT_TO_STR_CACHE_SIZE;
@@ -160,44 +229,155 @@ MVMString * MVM_coerce_i_s(MVMThreadContext *tc, MVMint64 i) {
             return cached;
     }
 
-    /* Otherwise, need to do the work; cache it if in range. */
-    len = snprintf(buffer, 64, "%lld", (long long int)i);
-    if (len >= 0) {
-        MVMString *result = MVM_string_ascii_decode(tc, tc->instance->VMString, buffer, len);
-        if (cache)
-            tc->instance->int_to_str_cache[i] = result;
-        return result;
+    /* Otherwise, need to do the work; the digits are all ASCII, so they go
+     * straight into 8-bit storage of the exact size. Cache it if in range. */
+    u      = i < 0 ? (MVMuint64)0 - (MVMuint64)i : (MVMuint64)i;
+    len    = count_digits(u) + (i < 0);
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+    result->body.storage.blob_8  = MVM_malloc(len);
+    result->body.num_graphs      = len;
+    format_int(i, (char *)result->body.storage.blob_8);
+    if (cache)
+        tc->instance->int_to_str_cache[i] = result;
+    return result;
+}
+
+/* Lays out the decimal digits of a finite, non-zero number, which is the
+ * digits times 10 ** K, like %.15g would: fixed point if the exponent is
+ * within range, scientific notation otherwise, and no trailing zeros after
+ * the decimal point. If out is NULL, only computes the length. */
+static size_t layout_num(const char *digits, MVMint32 len, MVMint32 K, int negative, char *out) {
+    MVMint32 X   = len + K - 1;
+    size_t   pos = 0;
+    MVMint32 j;
+
+    if (negative) {
+        if (out) out[pos] = '-';
+        pos++;
+    }
+
+    if (X < -4 || X >= 15) {
+        /* Scientific, with at least two digits of exponent. */
+        MVMint32 exp = X < 0 ? -X : X;
+        if (out) out[pos] = digits[0];
+        pos++;
+        if (len > 1) {
+            if (out) {
+                out[pos] = '.';
+                memcpy(out + pos + 1, digits + 1, len - 1);
+            }
+            pos += len;
+        }
+        if (out) {
+            out[pos]     = 'e';
+            out[pos + 1] = X < 0 ? '-' : '+';
+        }
+        pos += 2;
+        if (exp < 10) {
+            if (out) out[pos] = '0';
+            pos++;
+        }
+        j = exp < 10 ? 1 : exp < 100 ? 2 : 3;
+        if (out) write_digits((MVMuint64)exp, out + pos + j);
+        pos += j;
+    }
+    else if (K >= 0) {
+        /* An integer; pad with zeros. */
+        if (out) {
+            memcpy(out + pos, digits, len);
+            memset(out + pos + len, '0', K);
+        }
+        pos += len + K;
+    }
+    else if (X >= 0) {
+        /* Decimal point falls within the digits. */
+        if (out) {
+            memcpy(out + pos, digits, X + 1);
+            out[pos + X + 1] = '.';
+            memcpy(out + pos + X + 2, digits + X + 1, len - X - 1);
+        }
+        pos += len + 1;
     }
     else {
-        MVM_exception_throw_adhoc(tc, "Could not stringify integer");
+        /* Below one; leading zeros after the decimal point. */
+        if (out) {
+            out[pos]     = '0';
+            out[pos + 1] = '.';
+            memset(out + pos + 2, '0', -X - 1);
+            memcpy(out + pos + 1 - X, digits, len);
+        }
+        pos += 1 - X + len;
     }
+
+    return pos;
 }
 
-MVMString * MVM_coerce_n_s(MVMThreadContext *tc, MVMnum64 n) {
+/* Produces the shortest digits that round trip for a finite, non-zero
+ * number, with trailing zeros dropped. */
+static MVMint32 num_digits(MVMnum64 n, char *digits, MVMint32 *K) {
+    MVMint32 len = MVM_num_shortest_digits(n < 0 ? -n : n, digits, K);
+    while (len > 1 && digits[len - 1] == '0') {
+        len--;
+        (*K)++;
+    }
+    return len;
+}
+
+/* Formats a number into the buffer, which must have space for at least
+ * MVM_COERCE_BUFFER_SIZE characters, returning the length. */
+size_t MVM_coerce_n_buf(MVMThreadContext *tc, MVMnum64 n, char *buf) {
     if (n == MVM_num_posinf(tc)) {
-        return MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "Inf");
+        strcpy(buf, "Inf");
     }
     else if (n == MVM_num_neginf(tc)) {
-        return MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "-Inf");
+        strcpy(buf, "-Inf");
     }
     else if (n != n) {
-        return MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "NaN");
+        strcpy(buf, "NaN");
+    }
+    else if (n == 0.0) {
+        /* Negative zero is only told apart by dividing by it. */
+        strcpy(buf, 1.0 / n < 0 ? "-0" : "0");
     }
     else {
-        char buf[64];
-        int i;
-        if (snprintf(buf, 64, "%.15g", n) < 0)
-            MVM_exception_throw_adhoc(tc, "Could not stringify number");
-        if (strstr(buf, ".")) {
-            MVMint64 is_not_scientific = !strstr(buf, "e");
-            i = strlen(buf);
-            while (i > 1 && ((buf[--i] == '0'  && is_not_scientific) || buf[i] == ' '))
-                buf[i] = '\0';
-            if (buf[i] == '.')
-                buf[i] = '\0';
-        }
-        return MVM_string_ascii_decode(tc, tc->instance->VMString, buf, strlen(buf));
+        char     digits[20];
+        MVMint32 K;
+        MVMint32 len = num_digits(n, digits, &K);
+        size_t   out = layout_num(digits, len, K, n < 0, buf);
+        buf[out] = '\0';
+        return out;
+    }
+    return strlen(buf);
+}
+
+MVMString * MVM_coerce_n_s(MVMThreadContext *tc, MVMnum64 n) {
+    MVMString *result;
+    char      *blob;
+    size_t     len;
+
+    /* Finite numbers are laid out straight into 8-bit storage of the exact
+     * size; the special cases are short enough to go via a buffer. */
+    if (n != 0.0 && !MVM_num_isnanorinf(tc, n)) {
+        char     digits[20];
+        MVMint32 K;
+        MVMint32 num_len = num_digits(n, digits, &K);
+        len  = layout_num(digits, num_len, K, n < 0, NULL);
+        blob = MVM_malloc(len);
+        layout_num(digits, num_len, K, n < 0, blob);
+    }
+    else {
+        char buf[MVM_COERCE_BUFFER_SIZE];
+        len  = MVM_coerce_n_buf(tc, n, buf);
+        blob = MVM_malloc(len);
+        memcpy(blob, buf, len);
     }
+
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+    result->body.storage.blob_8 = (MVMGrapheme8 *)blob;
+    result->body.num_graphs     = len;
+    return result;
 }
 
 void MVM_coerce_smart_stringify(MVMThreadContext *tc, MVMObject *obj, MVMRegister *res_reg) {
@@ -250,9 +430,60 @@ void MVM_coerce_smart_stringify(MVMThreadContext *tc, MVMObject *obj, MVMRegiste
     }
 }
 
+/* Parses an integer from a flat 8-bit string the way strtoll would, reading
+ * the digits straight out of storage, eight at a time where possible.
+ * Returns 0 if the string holds a synthetic anywhere, since the ASCII encode
+ * in the slow path throws for those. */
+static int coerce_flat_s_i(MVMString *s, MVMint64 *result) {
+    const MVMGrapheme8 *p     = s->body.storage.blob_8;
+    const MVMGrapheme8 *end   = p + s->body.num_graphs;
+    MVMuint64           u     = 0;
+    MVMuint64           limit = 0x7FFFFFFFFFFFFFFFULL;
+    MVMuint64           chunk;
+    int                 negative = 0, overflow = 0;
+
+    while (p < end && (*p == ' ' || (*p >= 9 && *p <= 13)))
+        p++;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    while (end - p >= 8 && MVM_parse_eight_digits(p, &chunk)) {
+        if (u > (0xFFFFFFFFFFFFFFFFULL - chunk) / 100000000)
+            overflow = 1;
+        else
+            u = u * 100000000 + chunk;
+        p += 8;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        MVMuint64 digit = *p - '0';
+        if (u > (0xFFFFFFFFFFFFFFFFULL - digit) / 10)
+            overflow = 1;
+        else
+            u = u * 10 + digit;
+        p++;
+    }
+    while (p < end)
+        if (*p++ < 0)
+            return 0;
+
+    /* Out of range values saturate, as with strtoll. */
+    if (negative)
+        limit++;
+    if (overflow || u > limit)
+        u = limit;
+    *result = negative && u ? -(MVMint64)(u - 1) - 1 : (MVMint64)u;
+    return 1;
+}
+
 MVMint64 MVM_coerce_s_i(MVMThreadContext *tc, MVMString *s) {
-    char     *enc = MVM_string_ascii_encode(tc, s, NULL, 0);
-    MVMint64  i   = strtoll(enc, NULL, 10);
+    char     *enc;
+    MVMint64  i;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_8 && coerce_flat_s_i(s, &i))
+        return i;
+    enc = MVM_string_ascii_encode(tc, s, NULL, 0);
+    i   = strtoll(enc, NULL, 10);
     MVM_free(enc);
     return i;
 }
@@ -343,6 +574,12 @@ MVMObject * MVM_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *str, MVMi
     MVMuint16  neg  = 0;
     MVMint64   ch;
 
+    /* Decimal digits in flat 8-bit strings can be taken in runs of eight,
+     * unless we need to track the last non-zero digit. */
+    const MVMGrapheme8 *blob_8 = radix == 10 && !(flag & 0x04)
+        && str->body.storage_type == MVM_STRING_GRAPHEME_8
+        ? str->body.storage.blob_8 : NULL;
+
     if (radix > 36) {
         MVM_exception_throw_adhoc(tc, "Cannot convert radix of %"PRId64" (max 36)", radix);
     }
@@ -355,6 +592,15 @@ MVMObject * MVM_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *str, MVMi
     }
 
     while (offset < chars) {
+        MVMuint64 chunk;
+        if (blob_8 && chars - offset >= 8 && MVM_parse_eight_digits(blob_8 + offset, &chunk)) {
+            /* Take the first seven digits here, leaving the last to go
+             * through the usual path. */
+            zvalue = zvalue * 10000000 + (MVMint64)(chunk / 10);
+            zbase  = zbase * 10000000;
+            offset += 7;
+            ch = blob_8[offset];
+        }
         if (ch >= '0' && ch <= '9') ch = ch - '0'; /* fast-path for ASCII 0..9 */
         else if (ch >= 'a' && ch <= 'z') ch = ch - 'a' + 10;
         else if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 10;
@@ -6,6 +6,8 @@ void MVM_coerce_istrue(MVMThreadContext *tc, MVMObject *obj, MVMRegister *res_re
 /* Stringification. */
 MVMString * MVM_coerce_i_s(MVMThreadContext *tc, MVMint64 i);
 MVMString * MVM_coerce_n_s(MVMThreadContext *tc, MVMnum64 n);
+size_t MVM_coerce_i_buf(MVMThreadContext *tc, MVMint64 i, char *buffer);
+size_t MVM_coerce_n_buf(MVMThreadContext *tc, MVMnum64 n, char *buffer);
 void MVM_coerce_smart_stringify(MVMThreadContext *tc, MVMObject *obj, MVMRegister *res_reg);
 
 /* Numification. */
@@ -14,6 +16,9 @@ void MVM_coerce_smart_numify(MVMThreadContext *tc, MVMObject *obj, MVMRegister *
 MVMint64 MVM_coerce_simple_intify(MVMThreadContext *tc, MVMObject *obj);
 MVMObject* MVM_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *str, MVMint64 offset, MVMint64 flag);
 
+/* Space needed to format an integer or number into a buffer. */
+#define MVM_COERCE_BUFFER_SIZE 64
+
 /* Size of the int to string coercion cache (we cache 0 ..^ this). */
 #define MVM_INT_TO_STR_CACHE_SIZE 64
 
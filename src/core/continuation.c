@@ -146,6 +146,18 @@ void MVM_continuation_invoke(MVMThreadContext *tc, MVMContinuation *cont,
     });
     MVM_ASSIGN_REF(tc, &(cont->common.header), cont->body.root->caller, tc->cur_frame);
 
+    /* The frames of the continuation now have different callers, so their
+     * dynlex caches may point at the wrong registers. */
+    {
+        MVMFrame *f = cont->body.top;
+        while (f) {
+            MVM_frame_clear_dynlex_cache(tc, f);
+            if (f == cont->body.root)
+                break;
+            f = f->caller;
+        }
+    }
+
     /* Set up current frame to receive result. */
     tc->cur_frame->return_value = res_reg;
     tc->cur_frame->return_type = MVM_RETURN_OBJ;
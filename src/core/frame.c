@@ -3,6 +3,10 @@
 /* This allows the dynlex cache to be disabled when bug hunting, if needed. */
 #define MVM_DYNLEX_CACHE_ENABLED 1
 
+/* How many frames apart we cache a dynamic variable lookup along the caller
+ * chain it walked. */
+#define MVM_DYNLEX_CACHE_STRIDE 8
+
 /* Computes the initial work area for a frame or a specialization of a frame. */
 MVMRegister * MVM_frame_initial_work(MVMThreadContext *tc, MVMuint16 *local_types,
                                      MVMuint16 num_locals) {
@@ -103,6 +107,8 @@ void MVM_frame_destroy(MVMThreadContext *tc, MVMFrame *frame) {
         MVM_fixed_size_free(tc, tc->instance->fsa, frame->allocd_env, frame->env);
     if (frame->continuation_tags)
         MVM_continuation_free_tags(tc, frame);
+    if (frame->dynlex_cache)
+        MVM_frame_clear_dynlex_cache(tc, frame);
 }
 
 /* Creates a frame for usage as a context only, possibly forcing all of the
@@ -778,6 +784,11 @@ static MVMuint64 remove_one_frame(MVMThreadContext *tc, MVMuint8 unwind) {
     if (returner->continuation_tags)
         MVM_continuation_free_tags(tc, returner);
 
+    /* The dynlex cache points into our callers, and so is no good once we
+     * are out of dynamic scope. */
+    if (returner->dynlex_cache)
+        MVM_frame_clear_dynlex_cache(tc, returner);
+
     /* Clean up frame working space. */
     if (returner->work) {
         MVM_args_proc_cleanup(tc, &returner->params);
@@ -1157,35 +1168,143 @@ MVMObject * MVM_frame_vivify_lexical(MVMThreadContext *tc, MVMFrame *f, MVMuint1
     }
 }
 
+/* Adds a lexical lookup to a static frame's lookup cache. Entries are never
+ * changed once installed; we make a new one and swap it in, freeing the old
+ * one at the next safepoint, so that other threads can read the cache
+ * without taking a lock. */
+static void add_lexical_lookup(MVMThreadContext *tc, MVMStaticFrame *sf, MVMuint32 slot,
+        MVMString *name, MVMuint16 depth, MVMuint16 idx) {
+    MVMLexicalLookupCacheEntry **cache = sf->body.lexical_lookup_cache;
+    MVMLexicalLookupCacheEntry  *old_entry, *new_entry;
+
+    /* Allocate the cache if needed; if we lose a race to do so, use the one
+     * that won. */
+    if (!cache) {
+        cache = MVM_calloc(MVM_LEXICAL_LOOKUP_CACHE_SIZE, sizeof(MVMLexicalLookupCacheEntry *));
+        if (!MVM_trycas(&(sf->body.lexical_lookup_cache), NULL, cache)) {
+            MVM_free(cache);
+            cache = sf->body.lexical_lookup_cache;
+        }
+    }
+
+    new_entry        = MVM_fixed_size_alloc(tc, tc->instance->fsa, sizeof(MVMLexicalLookupCacheEntry));
+    new_entry->name  = name;
+    new_entry->depth = depth;
+    new_entry->idx   = idx;
+    MVM_gc_write_barrier(tc, (MVMCollectable *)sf, (MVMCollectable *)name);
+
+    old_entry = cache[slot];
+    if (MVM_trycas(&(cache[slot]), old_entry, new_entry)) {
+        if (old_entry)
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                sizeof(MVMLexicalLookupCacheEntry), old_entry);
+    }
+    else {
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            sizeof(MVMLexicalLookupCacheEntry), new_entry);
+    }
+}
+
+/* Frees a static frame's lexical lookup cache. */
+void MVM_frame_lexical_lookup_cache_destroy(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMLexicalLookupCacheEntry **cache = sf->body.lexical_lookup_cache;
+    if (cache) {
+        MVMuint32 i;
+        for (i = 0; i < MVM_LEXICAL_LOOKUP_CACHE_SIZE; i++)
+            if (cache[i])
+                MVM_fixed_size_free(tc, tc->instance->fsa,
+                    sizeof(MVMLexicalLookupCacheEntry), cache[i]);
+        MVM_free(cache);
+        sf->body.lexical_lookup_cache = NULL;
+    }
+}
+
+/* Finds the frame holding the lexical with the specified name, walking the
+ * outer chain from the specified frame. Returns NULL if there is no such
+ * lexical, and otherwise puts its index into idx. We first look in the
+ * lookup cache of the starting frame's static frame, and add what we find
+ * to it if we have to walk the chain. */
+static MVMFrame * find_lexical_frame(MVMThreadContext *tc, MVMString *name,
+        MVMFrame *cur_frame, MVMuint16 *idx) {
+    MVMStaticFrame             *sf;
+    MVMLexicalLookupCacheEntry *cached;
+    MVMuint32                   slot, depth, static_chain;
+
+    if (!cur_frame)
+        return NULL;
+
+    /* Hashing and the walk below will complain about bad names. */
+    if (MVM_is_null(tc, (MVMObject *)name) || REPR(name)->ID != MVM_REPR_ID_MVMString
+            || !IS_CONCRETE(name))
+        MVM_exception_throw_adhoc(tc, "Hash keys must be concrete strings");
+    if (!name->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, name);
+    slot = name->body.cached_hash_code & (MVM_LEXICAL_LOOKUP_CACHE_SIZE - 1);
+
+    /* See if we have a cached lookup, and if the outer chain is the one it
+     * was made for. */
+    sf     = cur_frame->static_info;
+    cached = sf->body.lexical_lookup_cache ? sf->body.lexical_lookup_cache[slot] : NULL;
+    if (cached && (cached->name == name || MVM_string_equal(tc, cached->name, name))) {
+        MVMFrame *found = cur_frame;
+        for (depth = 0; depth < cached->depth; depth++) {
+            MVMFrame *outer = found->outer;
+            if (!outer || outer->static_info != found->static_info->body.outer)
+                break;
+            found = outer;
+        }
+        if (depth == cached->depth) {
+            *idx = cached->idx;
+            return found;
+        }
+    }
+
+    /* Otherwise, walk the chain. We can only cache the result if each outer
+     * we pass through is of the static outer of the frame before it. */
+    depth        = 0;
+    static_chain = 1;
+    while (cur_frame != NULL) {
+        MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, cur_frame->static_info, name);
+        if (entry) {
+            *idx = entry->index;
+            if (static_chain && depth <= 0xFFFF)
+                add_lexical_lookup(tc, sf, slot, name, depth, entry->index);
+            return cur_frame;
+        }
+        if (cur_frame->outer && cur_frame->outer->static_info != cur_frame->static_info->body.outer)
+            static_chain = 0;
+        cur_frame = cur_frame->outer;
+        depth++;
+    }
+    return NULL;
+}
+
+/* Throws an exception about a lexical having the wrong type. */
+static void throw_wrong_lexical_type(MVMThreadContext *tc, MVMString *name) {
+    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+    char *waste[] = { c_name, NULL };
+    MVM_exception_throw_adhoc_free(tc, waste,
+        "Lexical with name '%s' has wrong type",
+            c_name);
+}
+
 /* Looks up the address of the lexical with the specified name and the
  * specified type. Non-existing object lexicals produce NULL, expected
  * (for better or worse) by various things. Otherwise, an error is thrown
  * if it does not exist. Incorrect type always throws. */
 MVMRegister * MVM_frame_find_lexical_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 type) {
-    MVMFrame *cur_frame = tc->cur_frame;
-    while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            /* Indexes were formerly stored off-by-one to avoid semi-predicate issue. */
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == type) {
-                    MVMRegister *result = &cur_frame->env[entry->value];
-                    if (type == MVM_reg_obj && !result->o)
-                        MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                    return result;
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
-            }
+    MVMuint16  idx;
+    MVMFrame  *found = find_lexical_frame(tc, name, tc->cur_frame, &idx);
+    if (found) {
+        if (found->static_info->body.lexical_types[idx] == type) {
+            MVMRegister *result = &found->env[idx];
+            if (type == MVM_reg_obj && !result->o)
+                MVM_frame_vivify_lexical(tc, found, idx);
+            return result;
+        }
+        else {
+            throw_wrong_lexical_type(tc, name);
         }
-        cur_frame = cur_frame->outer;
     }
     if (type != MVM_reg_obj) {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
@@ -1199,33 +1318,22 @@ MVMRegister * MVM_frame_find_lexical_by_name(MVMThreadContext *tc, MVMString *na
 /* Binds the specified value to the given lexical, finding it along the static
  * chain. */
 MVM_PUBLIC void MVM_frame_bind_lexical_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 type, MVMRegister *value) {
-    MVMFrame *cur_frame = tc->cur_frame;
-    while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == type) {
-                    if (type == MVM_reg_obj || type == MVM_reg_str) {
-                        MVM_ASSIGN_REF(tc, &(cur_frame->header),
-                            cur_frame->env[entry->value].o, value->o);
-                    }
-                    else {
-                        cur_frame->env[entry->value] = *value;
-                    }
-                    return;
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
+    MVMuint16  idx;
+    MVMFrame  *found = find_lexical_frame(tc, name, tc->cur_frame, &idx);
+    if (found) {
+        if (found->static_info->body.lexical_types[idx] == type) {
+            if (type == MVM_reg_obj || type == MVM_reg_str) {
+                MVM_ASSIGN_REF(tc, &(found->header),
+                    found->env[idx].o, value->o);
+            }
+            else {
+                found->env[idx] = *value;
             }
+            return;
+        }
+        else {
+            throw_wrong_lexical_type(tc, name);
         }
-        cur_frame = cur_frame->outer;
     }
     {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
@@ -1251,29 +1359,18 @@ MVMObject * MVM_frame_find_lexical_by_name_outer(MVMThreadContext *tc, MVMString
 /* Looks up the address of the lexical with the specified name, starting with
  * the specified frame. Only works if it's an object lexical.  */
 MVMRegister * MVM_frame_find_lexical_by_name_rel(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_frame) {
-    while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            /* Indexes were formerly stored off-by-one to avoid semi-predicate issue. */
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == MVM_reg_obj) {
-                    MVMRegister *result = &cur_frame->env[entry->value];
-                    if (!result->o)
-                        MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                    return result;
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
-            }
+    MVMuint16  idx;
+    MVMFrame  *found = find_lexical_frame(tc, name, cur_frame, &idx);
+    if (found) {
+        if (found->static_info->body.lexical_types[idx] == MVM_reg_obj) {
+            MVMRegister *result = &found->env[idx];
+            if (!result->o)
+                MVM_frame_vivify_lexical(tc, found, idx);
+            return result;
+        }
+        else {
+            throw_wrong_lexical_type(tc, name);
         }
-        cur_frame = cur_frame->outer;
     }
     return NULL;
 }
@@ -1282,68 +1379,87 @@ MVMRegister * MVM_frame_find_lexical_by_name_rel(MVMThreadContext *tc, MVMString
  * the specified frame. It checks all outer frames of the caller frame chain.  */
 MVMRegister * MVM_frame_find_lexical_by_name_rel_caller(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_caller_frame) {
     while (cur_caller_frame != NULL) {
-        MVMFrame *cur_frame = cur_caller_frame;
-        while (cur_frame != NULL) {
-            MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-            if (lexical_names) {
-                /* Indexes were formerly stored off-by-one to avoid semi-predicate issue. */
-                MVMLexicalRegistry *entry;
-                MVM_HASH_GET(tc, lexical_names, name, entry)
-                if (entry) {
-                    if (cur_frame->static_info->body.lexical_types[entry->value] == MVM_reg_obj) {
-                        MVMRegister *result = &cur_frame->env[entry->value];
-                        if (!result->o)
-                            MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                        return result;
-                    }
-                    else {
-                        char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                        char *waste[] = { c_name, NULL };
-                        MVM_exception_throw_adhoc_free(tc, waste,
-                            "Lexical with name '%s' has wrong type",
-                                c_name);
-                    }
-                }
-            }
-            cur_frame = cur_frame->outer;
-        }
+        MVMRegister *result = MVM_frame_find_lexical_by_name_rel(tc, name, cur_caller_frame);
+        if (result)
+            return result;
         cur_caller_frame = cur_caller_frame->caller;
     }
     return NULL;
 }
 
-/* Looks up the address of the lexical with the specified name and the
- * specified type. Returns null if it does not exist. */
-static void try_cache_dynlex(MVMThreadContext *tc, MVMFrame *from, MVMFrame *to, MVMString *name, MVMRegister *reg, MVMuint16 type, MVMuint32 fcost, MVMuint32 icost) {
-#if MVM_DYNLEX_CACHE_ENABLED
-    MVMint32 next = 0;
-    MVMint32 frames = 0;
-    MVMuint32 desperation = 0;
+/* Frees a frame's dynamic variable lookup cache, if it has one. */
+void MVM_frame_clear_dynlex_cache(MVMThreadContext *tc, MVMFrame *f) {
+    if (f->dynlex_cache) {
+        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMDynlexCache),
+            f->dynlex_cache);
+        f->dynlex_cache = NULL;
+    }
+}
+
+/* Adds an entry to a frame's dynamic variable lookup cache, replacing any
+ * entry for the same name, or else an unused one, or else the oldest one. */
+static void add_dynlex_cache_entry(MVMThreadContext *tc, MVMFrame *f, MVMString *name,
+                                   MVMRegister *reg, MVMuint16 type) {
+    MVMDynlexCache      *cache = f->dynlex_cache;
+    MVMDynlexCacheEntry *entry = NULL;
+    MVMuint32 i;
+    if (!cache) {
+        cache = f->dynlex_cache = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+            sizeof(MVMDynlexCache));
+    }
+    else {
+        for (i = 0; i < MVM_DYNLEX_CACHE_SIZE; i++) {
+            MVMString *cached = cache->entries[i].name;
+            if (!cached || cached == name || MVM_string_equal(tc, cached, name)) {
+                entry = &(cache->entries[i]);
+                break;
+            }
+        }
+    }
+    if (!entry) {
+        entry = &(cache->entries[cache->next]);
+        cache->next = (cache->next + 1) % MVM_DYNLEX_CACHE_SIZE;
+    }
+    MVM_ASSIGN_REF(tc, &(f->header), entry->name, name);
+    entry->reg  = reg;
+    entry->type = type;
+}
 
-    if (fcost+icost > 20)
-        desperation = 1;
+/* Looks in a frame's dynamic variable lookup cache. */
+MVM_STATIC_INLINE MVMDynlexCacheEntry * find_dynlex_cache_entry(MVMThreadContext *tc,
+        MVMDynlexCache *cache, MVMString *name) {
+    MVMuint32 i;
+    for (i = 0; i < MVM_DYNLEX_CACHE_SIZE; i++) {
+        MVMString *cached = cache->entries[i].name;
+        if (!cached)
+            break;
+        if (cached == name || MVM_string_equal(tc, cached, name))
+            return &(cache->entries[i]);
+    }
+    return NULL;
+}
 
+/* Having found a dynamic variable by walking from one frame to another, we
+ * cache where it lives in the frame we started from, and then in every
+ * MVM_DYNLEX_CACHE_STRIDE'th frame along the way, so that lookups starting in
+ * any frame in between walk at most that many frames to find it. Nothing
+ * between the frames we cache in and where it was found declares the name,
+ * so the entries stay valid for as long as the frames do. */
+static void try_cache_dynlex(MVMThreadContext *tc, MVMFrame *from, MVMFrame *to, MVMString *name, MVMRegister *reg, MVMuint16 type) {
+#if MVM_DYNLEX_CACHE_ENABLED
+    MVMuint32 frames = 0;
     while (from && from != to) {
+        if (frames % MVM_DYNLEX_CACHE_STRIDE == 0)
+            add_dynlex_cache_entry(tc, from, name, reg, type);
         frames++;
-        if (frames >= next) {
-            if (!from->dynlex_cache_name || (desperation && frames > 1)) {
-                MVM_ASSIGN_REF(tc, &(from->header), from->dynlex_cache_name, name);
-                from->dynlex_cache_reg  = reg;
-                from->dynlex_cache_type = type;
-                if (desperation && next == 3) {
-                    next = fcost / 2;
-                }
-                else {
-                    if (next)
-                        return;
-                    next = 3;
-                }
-            }
-        }
         from = from->caller;
     }
 #endif
 }
+
+/* Looks up the address of the dynamic variable with the specified name,
+ * starting at the specified frame and walking the callers. Returns null if
+ * it does not exist. */
 MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 *type, MVMFrame *cur_frame, MVMint32 vivify, MVMFrame **found_frame) {
     FILE *dlog = tc->instance->dynvar_log_fh;
     MVMuint32 fcost = 0;  /* frames traversed */
@@ -1364,7 +1480,7 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
     }
 
     while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names;
+        MVMStrHashEntry    *entry;
         MVMSpeshCandidate  *cand     = cur_frame->spesh_cand;
         /* See if we are inside an inline. Note that this isn't actually
          * correct for a leaf frame, but those aren't inlined and don't
@@ -1382,33 +1498,29 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
                     icost++;
                     if (return_label >= labels[inls[i].start_label] && return_label <= labels[inls[i].end_label]) {
                         MVMStaticFrame *isf = cand->inlines[i].code->body.sf;
-                        if ((lexical_names = isf->body.lexical_names)) {
-                            MVMLexicalRegistry *entry;
-                            MVM_HASH_GET(tc, lexical_names, name, entry);
-                            if (entry) {
-                                MVMuint16    lexidx = cand->inlines[i].lexicals_start + entry->value;
-                                MVMRegister *result = &cur_frame->env[lexidx];
-                                *type = cand->lexical_types[lexidx];
-                                if (vivify && *type == MVM_reg_obj && !result->o) {
-                                    MVMROOT(tc, cur_frame, {
-                                    MVMROOT(tc, initial_frame, {
-                                    MVMROOT(tc, name, {
-                                        MVM_frame_vivify_lexical(tc, cur_frame, lexidx);
-                                    });
-                                    });
-                                    });
-                                }
-                                if (fcost+icost > 1)
-                                  try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type, fcost, icost);
-                                if (dlog) {
-                                    fprintf(dlog, "I %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
-                                    fflush(dlog);
-                                    MVM_free(c_name);
-                                    tc->instance->dynvar_log_lasttime = uv_hrtime();
-                                }
-                                *found_frame = cur_frame;
-                                return result;
+                        if ((entry = MVM_static_frame_lexical(tc, isf, name))) {
+                            MVMuint16    lexidx = cand->inlines[i].lexicals_start + entry->index;
+                            MVMRegister *result = &cur_frame->env[lexidx];
+                            *type = cand->lexical_types[lexidx];
+                            if (vivify && *type == MVM_reg_obj && !result->o) {
+                                MVMROOT(tc, cur_frame, {
+                                MVMROOT(tc, initial_frame, {
+                                MVMROOT(tc, name, {
+                                    MVM_frame_vivify_lexical(tc, cur_frame, lexidx);
+                                });
+                                });
+                                });
                             }
+                            if (fcost+icost > 1)
+                              try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type);
+                            if (dlog) {
+                                fprintf(dlog, "I %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
+                                fflush(dlog);
+                                MVM_free(c_name);
+                                tc->instance->dynvar_log_lasttime = uv_hrtime();
+                            }
+                            *found_frame = cur_frame;
+                            return result;
                         }
                     }
                 }
@@ -1419,33 +1531,29 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
                     icost++;
                     if (ret_offset >= cand->inlines[i].start && ret_offset < cand->inlines[i].end) {
                         MVMStaticFrame *isf = cand->inlines[i].code->body.sf;
-                        if ((lexical_names = isf->body.lexical_names)) {
-                            MVMLexicalRegistry *entry;
-                            MVM_HASH_GET(tc, lexical_names, name, entry);
-                            if (entry) {
-                                MVMuint16    lexidx = cand->inlines[i].lexicals_start + entry->value;
-                                MVMRegister *result = &cur_frame->env[lexidx];
-                                *type = cand->lexical_types[lexidx];
-                                if (vivify && *type == MVM_reg_obj && !result->o) {
-                                    MVMROOT(tc, cur_frame, {
-                                    MVMROOT(tc, initial_frame, {
-                                    MVMROOT(tc, name, {
-                                        MVM_frame_vivify_lexical(tc, cur_frame, lexidx);
-                                    });
-                                    });
-                                    });
-                                }
-                                if (fcost+icost > 1)
-                                  try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type, fcost, icost);
-                                if (dlog) {
-                                    fprintf(dlog, "I %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
-                                    fflush(dlog);
-                                    MVM_free(c_name);
-                                    tc->instance->dynvar_log_lasttime = uv_hrtime();
-                                }
-                                *found_frame = cur_frame;
-                                return result;
+                        if ((entry = MVM_static_frame_lexical(tc, isf, name))) {
+                            MVMuint16    lexidx = cand->inlines[i].lexicals_start + entry->index;
+                            MVMRegister *result = &cur_frame->env[lexidx];
+                            *type = cand->lexical_types[lexidx];
+                            if (vivify && *type == MVM_reg_obj && !result->o) {
+                                MVMROOT(tc, cur_frame, {
+                                MVMROOT(tc, initial_frame, {
+                                MVMROOT(tc, name, {
+                                    MVM_frame_vivify_lexical(tc, cur_frame, lexidx);
+                                });
+                                });
+                                });
+                            }
+                            if (fcost+icost > 1)
+                              try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type);
+                            if (dlog) {
+                                fprintf(dlog, "I %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
+                                fflush(dlog);
+                                MVM_free(c_name);
+                                tc->instance->dynvar_log_lasttime = uv_hrtime();
                             }
+                            *found_frame = cur_frame;
+                            return result;
                         }
                     }
                 }
@@ -1453,12 +1561,14 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
         }
 
         /* See if we've got it cached at this level. */
-        if (cur_frame->dynlex_cache_name) {
-            if (MVM_string_equal(tc, name, cur_frame->dynlex_cache_name)) {
-                MVMRegister *result = cur_frame->dynlex_cache_reg;
-                *type = cur_frame->dynlex_cache_type;
-                if (fcost+icost > 5)
-                    try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type, fcost, icost);
+        if (cur_frame->dynlex_cache) {
+            MVMDynlexCacheEntry *cached = find_dynlex_cache_entry(tc,
+                cur_frame->dynlex_cache, name);
+            if (cached) {
+                MVMRegister *result = cached->reg;
+                *type = cached->type;
+                if (fcost > 0)
+                    try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type);
                 if (dlog) {
                     fprintf(dlog, "C %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
                     fflush(dlog);
@@ -1475,32 +1585,28 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
             ecost++;
 
         /* Now look in the frame itself. */
-        if ((lexical_names = cur_frame->static_info->body.lexical_names)) {
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                MVMRegister *result = &cur_frame->env[entry->value];
-                *type = cur_frame->static_info->body.lexical_types[entry->value];
-                if (vivify && *type == MVM_reg_obj && !result->o) {
-                    MVMROOT(tc, cur_frame, {
-                    MVMROOT(tc, initial_frame, {
-                    MVMROOT(tc, name, {
-                        MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                    });
-                    });
-                    });
-                }
-                if (dlog) {
-                    fprintf(dlog, "F %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
-                    fflush(dlog);
-                    MVM_free(c_name);
-                    tc->instance->dynvar_log_lasttime = uv_hrtime();
-                }
-                if (fcost+icost > 1)
-                    try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type, fcost, icost);
-                *found_frame = cur_frame;
-                return result;
+        if ((entry = MVM_static_frame_lexical(tc, cur_frame->static_info, name))) {
+            MVMRegister *result = &cur_frame->env[entry->index];
+            *type = cur_frame->static_info->body.lexical_types[entry->index];
+            if (vivify && *type == MVM_reg_obj && !result->o) {
+                MVMROOT(tc, cur_frame, {
+                MVMROOT(tc, initial_frame, {
+                MVMROOT(tc, name, {
+                    MVM_frame_vivify_lexical(tc, cur_frame, entry->index);
+                });
+                });
+                });
+            }
+            if (dlog) {
+                fprintf(dlog, "F %s %d %d %d %d %"PRIu64" %"PRIu64" %"PRIu64"\n", c_name, fcost, icost, ecost, xcost, last_time, start_time, uv_hrtime());
+                fflush(dlog);
+                MVM_free(c_name);
+                tc->instance->dynvar_log_lasttime = uv_hrtime();
             }
+            if (fcost+icost > 1)
+                try_cache_dynlex(tc, initial_frame, cur_frame, name, result, *type);
+            *found_frame = cur_frame;
+            return result;
         }
         fcost++;
         cur_frame = cur_frame->caller;
@@ -1602,13 +1708,9 @@ void MVM_frame_binddynlex(MVMThreadContext *tc, MVMString *name, MVMObject *valu
 /* Returns the storage unit for the lexical in the specified frame. Does not
  * try to vivify anything - gets exactly what is there. */
 MVMRegister * MVM_frame_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *name) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (lexical_names) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry)
-            return &f->env[entry->value];
-    }
+    MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, f->static_info, name);
+    if (entry)
+        return &f->env[entry->index];
 
     {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
@@ -1620,44 +1722,36 @@ MVMRegister * MVM_frame_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *na
 
 /* Returns the storage unit for the lexical in the specified frame. */
 MVMRegister * MVM_frame_try_get_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *name, MVMuint16 type) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (lexical_names) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry && f->static_info->body.lexical_types[entry->value] == type) {
-            MVMRegister *result = &f->env[entry->value];
-            if (type == MVM_reg_obj && !result->o)
-                MVM_frame_vivify_lexical(tc, f, entry->value);
-            return result;
-        }
+    MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, f->static_info, name);
+    if (entry && f->static_info->body.lexical_types[entry->index] == type) {
+        MVMRegister *result = &f->env[entry->index];
+        if (type == MVM_reg_obj && !result->o)
+            MVM_frame_vivify_lexical(tc, f, entry->index);
+        return result;
     }
     return NULL;
 }
 
 /* Returns the primitive type specification for a lexical. */
 MVMuint16 MVM_frame_lexical_primspec(MVMThreadContext *tc, MVMFrame *f, MVMString *name) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (lexical_names) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry) {
-            switch (f->static_info->body.lexical_types[entry->value]) {
-                case MVM_reg_int64:
-                    return MVM_STORAGE_SPEC_BP_INT;
-                case MVM_reg_num64:
-                    return MVM_STORAGE_SPEC_BP_NUM;
-                case MVM_reg_str:
-                    return MVM_STORAGE_SPEC_BP_STR;
-                case MVM_reg_obj:
-                    return MVM_STORAGE_SPEC_BP_NONE;
-                default:
-                {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Unhandled lexical type in lexprimspec for '%s'",
-                        c_name);
-                }
+    MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, f->static_info, name);
+    if (entry) {
+        switch (f->static_info->body.lexical_types[entry->index]) {
+            case MVM_reg_int64:
+                return MVM_STORAGE_SPEC_BP_INT;
+            case MVM_reg_num64:
+                return MVM_STORAGE_SPEC_BP_NUM;
+            case MVM_reg_str:
+                return MVM_STORAGE_SPEC_BP_STR;
+            case MVM_reg_obj:
+                return MVM_STORAGE_SPEC_BP_NONE;
+            default:
+            {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+                char *waste[] = { c_name, NULL };
+                MVM_exception_throw_adhoc_free(tc, waste,
+                    "Unhandled lexical type in lexprimspec for '%s'",
+                    c_name);
             }
         }
     }
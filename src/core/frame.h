@@ -6,16 +6,60 @@
 #define MVM_FRAME_FLAG_HLL_3            1 << 5
 #define MVM_FRAME_FLAG_HLL_4            1 << 6
 
-/* Lexical hash entry for ->lexical_names on a frame. */
+/* Lexical name entry for ->lexical_names_list on a frame. */
 struct MVMLexicalRegistry {
     /* key string */
     MVMString *key;
 
     /* index of the lexical entry. */
     MVMuint32 value;
+};
+
+/* The number of entries in a static frame's lexical lookup cache. Must be a
+ * power of two. */
+#define MVM_LEXICAL_LOOKUP_CACHE_SIZE 8
+
+/* A cached lookup of a lexical by name, starting from a frame of the static
+ * frame that holds the cache. It says how many outers out the lexical was
+ * found, and at what index. The entry is only valid for frames whose outer
+ * chain follows the static outer chain, which we check as we walk it. Since
+ * a static frame's lexical table never changes once it is deserialized, and
+ * only deserialized frames can run, entries never go stale otherwise. */
+struct MVMLexicalLookupCacheEntry {
+    /* The name that was looked up. */
+    MVMString *name;
+
+    /* How many outers out it was found. */
+    MVMuint16 depth;
+
+    /* The lexical's index in the frame it was found in. */
+    MVMuint16 idx;
+};
+
+/* The number of entries in a frame's dynamic variable lookup cache. */
+#define MVM_DYNLEX_CACHE_SIZE 4
+
+/* A cached lookup of a dynamic variable from a frame: the register that a
+ * lookup of the name starting at that frame resolves to. */
+struct MVMDynlexCacheEntry {
+    /* The name that was looked up; NULL if the entry is unused. */
+    MVMString *name;
+
+    /* The register holding the dynamic variable, and its type. */
+    MVMRegister *reg;
+    MVMuint16    type;
+};
+
+/* A frame's dynamic variable lookup cache. Since it points at registers of
+ * frames further down the call stack, it is only valid while the frame is in
+ * dynamic scope and its callers stay the same; it is freed when the frame
+ * returns or is unwound, and cleared on deopt or when a continuation the
+ * frame is in gets invoked. */
+struct MVMDynlexCache {
+    MVMDynlexCacheEntry entries[MVM_DYNLEX_CACHE_SIZE];
 
-    /* the uthash hash handle inline struct. */
-    UT_hash_handle hash_handle;
+    /* The entry to replace next when all are in use. */
+    MVMuint8 next;
 };
 
 /* Entry in the linked list of continuation tags for the frame. */
@@ -126,11 +170,9 @@ struct MVMFrame {
     /* Linked list of any continuation tags we have. */
     MVMContinuationTag *continuation_tags;
 
-    /* Cache for dynlex lookup; if the name is non-null, the cache is valid
-     * and the register can be accessed directly to find the contextual. */
-    MVMString   *dynlex_cache_name;
-    MVMRegister *dynlex_cache_reg;
-    MVMuint16    dynlex_cache_type;
+    /* Cache for dynlex lookups starting at this frame, allocated the first
+     * time something is cached here. */
+    MVMDynlexCache *dynlex_cache;
 
     /* The allocated work/env sizes. */
     MVMuint16 allocd_work;
@@ -203,6 +245,8 @@ MVM_PUBLIC void MVM_frame_bind_lexical_by_name(MVMThreadContext *tc, MVMString *
 MVMObject * MVM_frame_find_lexical_by_name_outer(MVMThreadContext *tc, MVMString *name);
 MVM_PUBLIC MVMRegister * MVM_frame_find_lexical_by_name_rel(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_frame);
 MVM_PUBLIC MVMRegister * MVM_frame_find_lexical_by_name_rel_caller(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_caller_frame);
+void MVM_frame_lexical_lookup_cache_destroy(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_frame_clear_dynlex_cache(MVMThreadContext *tc, MVMFrame *f);
 MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 *type, MVMFrame *cur_frame, MVMint32 vivify, MVMFrame **found_frame);
 MVMObject * MVM_frame_getdynlex(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_frame);
 void MVM_frame_binddynlex(MVMThreadContext *tc, MVMString *name, MVMObject *value, MVMFrame *cur_frame);
@@ -0,0 +1,165 @@
+#include "moar.h"
+
+/* Sets up the inline cache for an unspecialized static frame's bytecode. The
+ * bytecode validator tells us the smallest distance between two method
+ * lookup sites, so we can pick a shift that gives every site its own slot
+ * while keeping the slot array as small as we can. */
+void MVM_inline_cache_setup(MVMThreadContext *tc, MVMInlineCache *cache,
+        MVMuint8 *bytecode, MVMuint32 bytecode_size, MVMuint32 min_site_distance) {
+    MVMuint32 bit_shift = 0;
+    while ((2u << bit_shift) <= min_site_distance)
+        bit_shift++;
+    cache->bit_shift   = bit_shift;
+    cache->num_entries = (bytecode_size >> bit_shift) + 1;
+    cache->entries     = MVM_calloc(cache->num_entries, sizeof(MVMMethodInlineCacheEntry *));
+    cache->bytecode    = bytecode;
+}
+
+/* Sets up the inline cache for a specialization. Method lookup sites in
+ * specialized code carry a spesh slot index, which we use to identify the
+ * site; this means inlining, which renumbers spesh slots, does the right
+ * thing for free. */
+void MVM_inline_cache_setup_spesh(MVMThreadContext *tc, MVMInlineCache *cache,
+        MVMuint32 num_spesh_slots) {
+    cache->bit_shift   = 0;
+    cache->num_entries = num_spesh_slots;
+    cache->entries     = num_spesh_slots
+        ? MVM_calloc(num_spesh_slots, sizeof(MVMMethodInlineCacheEntry *))
+        : NULL;
+    cache->bytecode    = NULL;
+}
+
+/* Adds a type/method pair to a cache slot. We never modify an installed
+ * entry, but instead make a new one and swap it in. If we lose a race with
+ * another thread, then we just throw our entry away; the next lookup will
+ * try again anyway. */
+static void add_to_cache(MVMThreadContext *tc, MVMMethodInlineCacheEntry **slot,
+        AO_t epoch, MVMSTable *st, MVMObject *meth) {
+    MVMStaticFrame            *sf        = tc->cur_frame->static_info;
+    MVMMethodInlineCacheEntry *old_entry = *slot;
+    MVMMethodInlineCacheEntry *new_entry;
+    MVMuint32                  keep      = 0;
+
+    /* If the existing entry is still valid, we keep what is in it, unless
+     * it is full, in which case the site is megamorphic and we leave it be.
+     * Otherwise, we start over. */
+    if (old_entry && old_entry->epoch == epoch) {
+        if (old_entry->num_types >= MVM_INLINE_CACHE_MAX_TYPES)
+            return;
+        keep = old_entry->num_types;
+    }
+
+    new_entry = MVM_fixed_size_alloc(tc, tc->instance->fsa, sizeof(MVMMethodInlineCacheEntry));
+    new_entry->epoch     = epoch;
+    new_entry->num_types = keep + 1;
+    if (keep) {
+        memcpy(new_entry->types, old_entry->types, keep * sizeof(MVMSTable *));
+        memcpy(new_entry->methods, old_entry->methods, keep * sizeof(MVMObject *));
+    }
+    new_entry->types[keep]   = st;
+    new_entry->methods[keep] = meth;
+
+    /* The static frame owns the cache entries, and marks them. */
+    MVM_gc_write_barrier(tc, (MVMCollectable *)sf, (MVMCollectable *)st);
+    MVM_gc_write_barrier(tc, (MVMCollectable *)sf, (MVMCollectable *)meth);
+
+    if (MVM_trycas(slot, old_entry, new_entry)) {
+        if (old_entry)
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                sizeof(MVMMethodInlineCacheEntry), old_entry);
+    }
+    else {
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            sizeof(MVMMethodInlineCacheEntry), new_entry);
+    }
+}
+
+/* Does a method lookup through an inline cache slot. Returns zero if we got
+ * a result right away, and non-zero if we had to fall back to a late-bound
+ * lookup (which may have invoked find_method on the meta-object). */
+static MVMint32 find_method(MVMThreadContext *tc, MVMMethodInlineCacheEntry **slot,
+        MVMObject *obj, MVMString *name, MVMRegister *res) {
+    MVMObject *meth;
+    AO_t       epoch;
+
+    /* If we have no slot or a null invocant, we take the slow path, which
+     * will also take care of the error reporting. */
+    if (!slot || MVM_is_null(tc, obj)) {
+        MVM_6model_find_method(tc, obj, name, res);
+        return 1;
+    }
+
+    /* See if we have it cached. */
+    meth = MVM_inline_cache_try(tc, *slot, STABLE(obj));
+    if (meth) {
+        res->o = meth;
+        return 0;
+    }
+
+    /* Missed; try a method cache lookup. We read the epoch before the lookup
+     * so a concurrent republish will make the entry we add stale. */
+    epoch = tc->instance->method_cache_epoch;
+    MVMROOT(tc, obj, {
+    MVMROOT(tc, name, {
+        meth = MVM_6model_find_method_cache_only(tc, obj, name);
+    });
+    });
+    if (!MVM_is_null(tc, meth)) {
+        add_to_cache(tc, slot, epoch, STABLE(obj), meth);
+        res->o = meth;
+        return 0;
+    }
+
+    /* Fully late-bound. */
+    MVM_6model_find_method(tc, obj, name, res);
+    return 1;
+}
+
+/* Looks up a method for the findmeth family of ops, consulting the inline
+ * cache slot if one is available. */
+void MVM_inline_cache_find_method(MVMThreadContext *tc, MVMMethodInlineCacheEntry **slot,
+        MVMObject *obj, MVMString *name, MVMRegister *res) {
+    find_method(tc, slot, obj, name, res);
+}
+
+/* Looks up a method for sp_findmeth, which identifies its cache slot by a
+ * spesh slot index. Returns non-zero if we did a late-bound lookup, which
+ * the JIT needs to know about, since it may have invoked code. */
+MVMint32 MVM_inline_cache_find_method_spesh(MVMThreadContext *tc, MVMObject *obj,
+        MVMString *name, MVMint32 ss_idx, MVMRegister *res) {
+    MVMInlineCache *cache = &(tc->cur_frame->spesh_cand->inline_cache);
+    return find_method(tc, &(cache->entries[ss_idx]), obj, name, res);
+}
+
+/* Called whenever a method cache is published or the authoritativeness of
+ * one changes. Bumping the epoch makes every existing entry stale. */
+void MVM_inline_cache_invalidate(MVMThreadContext *tc) {
+    MVM_incr(&(tc->instance->method_cache_epoch));
+}
+
+/* Adds the types and methods held in a cache to the GC worklist. */
+void MVM_inline_cache_mark(MVMThreadContext *tc, MVMInlineCache *cache, MVMGCWorklist *worklist) {
+    MVMuint32 i, j;
+    for (i = 0; i < cache->num_entries; i++) {
+        MVMMethodInlineCacheEntry *entry = cache->entries[i];
+        if (entry) {
+            for (j = 0; j < entry->num_types; j++) {
+                MVM_gc_worklist_add(tc, worklist, &(entry->types[j]));
+                MVM_gc_worklist_add(tc, worklist, &(entry->methods[j]));
+            }
+        }
+    }
+}
+
+/* Frees the memory associated with an inline cache. */
+void MVM_inline_cache_destroy(MVMThreadContext *tc, MVMInlineCache *cache) {
+    MVMuint32 i;
+    for (i = 0; i < cache->num_entries; i++)
+        if (cache->entries[i])
+            MVM_fixed_size_free(tc, tc->instance->fsa,
+                sizeof(MVMMethodInlineCacheEntry), cache->entries[i]);
+    MVM_free(cache->entries);
+    cache->entries     = NULL;
+    cache->num_entries = 0;
+    cache->bytecode    = NULL;
+}
@@ -0,0 +1,77 @@
+/* Inline caches for method lookup. Every bytecode site that looks up a
+ * method gets a slot, which points to an immutable entry holding a small
+ * number of STable => method pairs. Entries are never mutated once they
+ * are installed; an addition builds a new entry, swaps it into the slot
+ * and frees the old one at the next safepoint, so that other threads can
+ * read the slots without taking any locks. */
+
+/* The number of types a single site will cache before we consider it to be
+ * megamorphic and stop adding to it. */
+#define MVM_INLINE_CACHE_MAX_TYPES 4
+
+struct MVMMethodInlineCacheEntry {
+    /* The method cache epoch the entry was built in. If this does not match
+     * the instance epoch, some method cache was republished since, and so
+     * the entry is stale. */
+    AO_t epoch;
+
+    /* Number of types held in the entry. */
+    MVMuint32 num_types;
+
+    /* The types and the methods that they resolved to. */
+    MVMSTable *types[MVM_INLINE_CACHE_MAX_TYPES];
+    MVMObject *methods[MVM_INLINE_CACHE_MAX_TYPES];
+};
+
+struct MVMInlineCache {
+    /* Cache slots. For unspecialized bytecode, these are indexed by the
+     * offset of the op in the bytecode, shifted right by bit_shift, so we
+     * can go from the current op to the slot cheaply. For specialized code,
+     * they are indexed by the spesh slot that the op carries. */
+    MVMMethodInlineCacheEntry **entries;
+
+    /* The number of slots we have. */
+    MVMuint32 num_entries;
+
+    /* How far to shift bytecode offsets to get a slot index. */
+    MVMuint32 bit_shift;
+
+    /* The bytecode the offsets relate to; NULL for specializations. Since
+     * instrumentation swaps the bytecode of a frame, we check against it
+     * before using the cache. */
+    MVMuint8 *bytecode;
+};
+
+void MVM_inline_cache_setup(MVMThreadContext *tc, MVMInlineCache *cache,
+    MVMuint8 *bytecode, MVMuint32 bytecode_size, MVMuint32 min_site_distance);
+void MVM_inline_cache_setup_spesh(MVMThreadContext *tc, MVMInlineCache *cache,
+    MVMuint32 num_spesh_slots);
+void MVM_inline_cache_find_method(MVMThreadContext *tc, MVMMethodInlineCacheEntry **slot,
+    MVMObject *obj, MVMString *name, MVMRegister *res);
+MVMint32 MVM_inline_cache_find_method_spesh(MVMThreadContext *tc, MVMObject *obj,
+    MVMString *name, MVMint32 ss_idx, MVMRegister *res);
+void MVM_inline_cache_invalidate(MVMThreadContext *tc);
+void MVM_inline_cache_mark(MVMThreadContext *tc, MVMInlineCache *cache, MVMGCWorklist *worklist);
+void MVM_inline_cache_destroy(MVMThreadContext *tc, MVMInlineCache *cache);
+
+/* Looks in a cache entry for the method to use with the given STable. */
+MVM_STATIC_INLINE MVMObject * MVM_inline_cache_try(MVMThreadContext *tc,
+        MVMMethodInlineCacheEntry *entry, MVMSTable *st) {
+    if (entry && entry->epoch == tc->instance->method_cache_epoch) {
+        MVMuint32 i;
+        for (i = 0; i < entry->num_types; i++)
+            if (entry->types[i] == st)
+                return entry->methods[i];
+    }
+    return NULL;
+}
+
+/* Gets the inline cache slot for an unspecialized method lookup op in the
+ * interpreter, or NULL if there is none (for example, because we are running
+ * specialized or instrumented bytecode). */
+MVM_STATIC_INLINE MVMMethodInlineCacheEntry ** MVM_inline_cache_interp_slot(MVMThreadContext *tc,
+        MVMInlineCache *cache, MVMuint8 *op_start, MVMuint8 *bytecode_start) {
+    if (cache->bytecode == bytecode_start)
+        return &(cache->entries[(op_start - bytecode_start) >> cache->bit_shift]);
+    return NULL;
+}
@@ -172,15 +172,26 @@ struct MVMInstance {
     /* int -> str cache */
     MVMString **int_to_str_cache;
 
+    /* Key for hashing strings; random per process. */
+    MVMuint64 hash_key[2];
+
     /* Multi-dispatch cache and specialization installation mutexes
      * (global, as the additions are quite low contention, so no
      * real motivation to have it more fine-grained at present). */
     uv_mutex_t mutex_multi_cache_add;
     uv_mutex_t mutex_spesh_install;
 
+    /* Method cache epoch; bumped whenever a method cache is published, so
+     * that inline caches know their entries are stale. */
+    AO_t method_cache_epoch;
+
     /* Log file for specializations, if we're to log them. */
     FILE *spesh_log_fh;
 
+    /* Op profile data, if we're building with op profiling and it was asked
+     * for (see profiler/opprofile.h). */
+    MVMOpProfile *op_profile;
+
     /* Log file for dynamic var performance, if we're to log it. */
     FILE *dynvar_log_fh;
     MVMint64 dynvar_log_lasttime;
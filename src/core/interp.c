@@ -38,7 +38,13 @@ MVM_STATIC_INLINE MVMuint16 check_lex(MVMThreadContext *tc, MVMFrame *f, MVMuint
 #define GET_UI32(pc, idx)   *((MVMuint32 *)(pc + idx))
 #define GET_N32(pc, idx)    *((MVMnum32 *)(pc + idx))
 
+#if MVM_OP_PROFILE
+#define NEXT_OP (op = *(MVMuint16 *)(cur_op), \
+    (tc->instance->op_profile ? MVM_op_profile_record(tc, &op_profile_cursor, cur_op, bytecode_start) : (void)0), \
+    cur_op += 2, op)
+#else
 #define NEXT_OP (op = *(MVMuint16 *)(cur_op), cur_op += 2, op)
+#endif
 
 #if MVM_CGOTO
 #define DISPATCH(op)
@@ -74,6 +80,11 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
     /* The current call site we're constructing. */
     MVMCallsite *cur_callsite = NULL;
 
+#if MVM_OP_PROFILE
+    /* Where we are up to in recording the op profile. */
+    MVMOpProfileCursor op_profile_cursor = { NULL, 0, NULL, NULL, 0 };
+#endif
+
     /* Stash addresses of current op, register base and SC deref base
      * in the TC; this will be used by anything that needs to switch
      * the current place we're interpreting. */
@@ -408,12 +419,11 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     MVMuint8 found = 0;
                     if (!sf->body.fully_deserialized)
                         MVM_bytecode_finish_frame(tc, sf->body.cu, sf, 0);
-                    if (sf->body.lexical_names) {
-                        MVMLexicalRegistry *entry;
-                        MVM_HASH_GET(tc, sf->body.lexical_names, name, entry);
-                        if (entry && sf->body.lexical_types[entry->value] == MVM_reg_obj) {
-                            MVM_ASSIGN_REF(tc, &(sf->common.header), sf->body.static_env[entry->value].o, val);
-                            sf->body.static_env_flags[entry->value] = (MVMuint8)flag;
+                    {
+                        MVMStrHashEntry *entry = MVM_static_frame_lexical(tc, sf, name);
+                        if (entry && sf->body.lexical_types[entry->index] == MVM_reg_obj) {
+                            MVM_ASSIGN_REF(tc, &(sf->common.header), sf->body.static_env[entry->index].o, val);
+                            sf->body.static_env_flags[entry->index] = (MVMuint8)flag;
                             found = 1;
                         }
                     }
@@ -1741,8 +1751,10 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVMRegister *res  = &GET_REG(cur_op, 0);
                 MVMObject   *obj  = GET_REG(cur_op, 2).o;
                 MVMString   *name = MVM_cu_string(tc, cu, GET_UI32(cur_op, 4));
+                MVMMethodInlineCacheEntry **slot = MVM_inline_cache_interp_slot(tc,
+                    &(tc->cur_frame->static_info->body.inline_cache), cur_op - 2, bytecode_start);
                 cur_op += 8;
-                MVM_6model_find_method(tc, obj, name, res);
+                MVM_inline_cache_find_method(tc, slot, obj, name, res);
                 goto NEXT;
             }
             OP(findmeth_s):  {
@@ -1750,8 +1762,10 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVMRegister *res  = &GET_REG(cur_op, 0);
                 MVMObject   *obj  = GET_REG(cur_op, 2).o;
                 MVMString   *name = GET_REG(cur_op, 4).s;
+                MVMMethodInlineCacheEntry **slot = MVM_inline_cache_interp_slot(tc,
+                    &(tc->cur_frame->static_info->body.inline_cache), cur_op - 2, bytecode_start);
                 cur_op += 6;
-                MVM_6model_find_method(tc, obj, name, res);
+                MVM_inline_cache_find_method(tc, slot, obj, name, res);
                 goto NEXT;
             }
             OP(can): {
@@ -2459,6 +2473,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVM_ASSIGN_REF(tc, &(stable->header), stable->method_cache, cache);
                 stable->method_cache_sc = NULL;
                 MVM_SC_WB_ST(tc, stable);
+                MVM_inline_cache_invalidate(tc);
 
                 cur_op += 4;
                 goto NEXT;
@@ -2471,6 +2486,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     new_flags |= MVM_METHOD_CACHE_AUTHORITATIVE;
                 STABLE(obj)->mode_flags = new_flags;
                 MVM_SC_WB_ST(tc, STABLE(obj));
+                MVM_inline_cache_invalidate(tc);
                 cur_op += 4;
                 goto NEXT;
             }
@@ -2587,7 +2603,8 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             }
             OP(ishash): {
                 MVMObject *obj = GET_REG(cur_op, 2).o;
-                GET_REG(cur_op, 0).i64 = obj && REPR(obj)->ID == MVM_REPR_ID_MVMHash ? 1 : 0;
+                GET_REG(cur_op, 0).i64 = obj && (REPR(obj)->ID == MVM_REPR_ID_MVMHash
+                    || REPR(obj)->ID == MVM_REPR_ID_ConcHash) ? 1 : 0;
                 cur_op += 4;
                 goto NEXT;
             }
@@ -5044,6 +5061,124 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 4;
                 goto NEXT;
             }
+            OP(strbuilderappend_s):
+                MVM_string_builder_append_str(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).s);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderappend_i):
+                MVM_string_builder_append_int(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderappend_n):
+                MVM_string_builder_append_num(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).n64);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderappendcp):
+                MVM_string_builder_append_codepoint(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderchars):
+                GET_REG(cur_op, 0).i64 = MVM_string_builder_chars(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(strbuilderfinish):
+                GET_REG(cur_op, 0).s = MVM_string_builder_finish(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(cas_o):
+                GET_REG(cur_op, 0).o = MVM_6model_container_cas(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            OP(cas_i):
+                GET_REG(cur_op, 0).i64 = MVM_6model_container_cas_i(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(atomicinc_i):
+                GET_REG(cur_op, 0).i64 = MVM_6model_container_atomic_inc(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(atomicdec_i):
+                GET_REG(cur_op, 0).i64 = MVM_6model_container_atomic_dec(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(atomicadd_i):
+                GET_REG(cur_op, 0).i64 = MVM_6model_container_atomic_add(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(atomicload_o):
+                GET_REG(cur_op, 0).o = MVM_6model_container_atomic_load(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(atomicload_i):
+                GET_REG(cur_op, 0).i64 = MVM_6model_container_atomic_load_i(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(atomicstore_o):
+                MVM_6model_container_atomic_store(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(atomicstore_i):
+                MVM_6model_container_atomic_store_i(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            OP(casattr_o):
+                GET_REG(cur_op, 0).o = MVM_repr_cas_attr_o(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).s,
+                    GET_REG(cur_op, 8).o, GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(atomicloadattr_o):
+                GET_REG(cur_op, 0).o = MVM_repr_atomic_load_attr_o(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).s);
+                cur_op += 8;
+                goto NEXT;
+            OP(atomicbindattr_o):
+                MVM_repr_atomic_bind_attr_o(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            OP(caspos_o):
+                GET_REG(cur_op, 0).o = MVM_repr_cas_pos_o(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o);
+                cur_op += 10;
+                goto NEXT;
+            OP(atomicloadpos_o):
+                GET_REG(cur_op, 0).o = MVM_repr_atomic_load_pos_o(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(atomicbindpos_o):
+                MVM_repr_atomic_bind_pos_o(tc, GET_REG(cur_op, 0).o,
+                    GET_REG(cur_op, 2).i64, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(barrierfull):
+                MVM_barrier();
+                goto NEXT;
+            OP(queuepushbatch):
+                MVM_concblockingqueue_push_batch(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(queuepollbatch):
+                GET_REG(cur_op, 0).i64 = MVM_concblockingqueue_poll_batch(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(schedulerstart):
+                MVM_conc_scheduler_start(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            OP(schedulersubmit):
+                MVM_conc_scheduler_submit(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(schedulerdepths):
+                GET_REG(cur_op, 0).o = MVM_conc_scheduler_depths(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
             OP(indexingoptimized):
                 GET_REG(cur_op, 0).s = MVM_string_indexing_optimized(tc, GET_REG(cur_op, 2).s);
                 cur_op += 4;
@@ -5273,11 +5408,14 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 4;
                 goto NEXT;
             OP(sp_findmeth): {
-                /* Obtain object and cache index; see if we get a match. */
-                MVMObject *obj = GET_REG(cur_op, 2).o;
-                MVMuint16  idx = GET_UI16(cur_op, 8);
-                if ((MVMSTable *)tc->cur_frame->effective_spesh_slots[idx] == STABLE(obj)) {
-                    GET_REG(cur_op, 0).o = (MVMObject *)tc->cur_frame->effective_spesh_slots[idx + 1];
+                /* Obtain object and inline cache index; see if we get a
+                 * match. */
+                MVMObject *obj  = GET_REG(cur_op, 2).o;
+                MVMuint16  idx  = GET_UI16(cur_op, 8);
+                MVMObject *meth = MVM_inline_cache_try(tc,
+                    tc->cur_frame->spesh_cand->inline_cache.entries[idx], STABLE(obj));
+                if (meth) {
+                    GET_REG(cur_op, 0).o = meth;
                     cur_op += 10;
                 }
                 else {
@@ -5285,8 +5423,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     MVMString *name = MVM_cu_string(tc, cu, GET_UI32(cur_op, 4));
                     MVMRegister *res = &GET_REG(cur_op, 0);
                     cur_op += 10;
-                    MVM_6model_find_method_spesh(tc, obj, name, idx, res);
-
+                    MVM_inline_cache_find_method_spesh(tc, obj, name, idx, res);
                 }
                 goto NEXT;
             }
@@ -5462,6 +5599,65 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 6;
                 goto NEXT;
             }
+            OP(sp_p6ocas_i): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = (MVMint64)MVM_cas((AO_t *)(data + GET_UI16(cur_op, 4)),
+                    (AO_t)GET_REG(cur_op, 6).i64, (AO_t)GET_REG(cur_op, 8).i64);
+                cur_op += 10;
+                goto NEXT;
+            }
+            OP(sp_p6oatomicinc_i): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = (MVMint64)MVM_incr(data + GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6oatomicdec_i): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = (MVMint64)MVM_decr(data + GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6oatomicadd_i): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = (MVMint64)MVM_add(data + GET_UI16(cur_op, 4),
+                    GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(sp_p6oatomicload_i): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = (MVMint64)MVM_load(data + GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6oatomicstore_i): {
+                MVMObject *o     = GET_REG(cur_op, 0).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                MVM_store(data + GET_UI16(cur_op, 2), GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6ocas_o):
+                GET_REG(cur_op, 0).o = MVM_p6opaque_atomic_cas_o(tc, GET_REG(cur_op, 2).o,
+                    GET_UI16(cur_op, 4), GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o);
+                cur_op += 10;
+                goto NEXT;
+            OP(sp_p6oatomicload_o):
+                GET_REG(cur_op, 0).o = MVM_p6opaque_atomic_load_o(tc, GET_REG(cur_op, 2).o,
+                    GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
+            OP(sp_p6oatomicbind_o):
+                MVM_p6opaque_atomic_bind_o(tc, GET_REG(cur_op, 0).o, GET_UI16(cur_op, 2),
+                    GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
             OP(sp_deref_get_i64): {
                 MVMObject *o      = GET_REG(cur_op, 2).o;
                 MVMint64 **target = ((MVMint64 **)((char *)o + GET_UI16(cur_op, 4)));
@@ -5517,8 +5713,10 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             }
             OP(sp_boolify_iter_hash): {
                 MVMIter *iter = (MVMIter *)GET_REG(cur_op, 2).o;
+                MVMStrHashTable *hash = &(((MVMHash *)iter->body.target)->body.hashtable);
 
-                GET_REG(cur_op, 0).i64 = iter->body.hash_state.next != NULL ? 1 : 0;
+                GET_REG(cur_op, 0).i64 = MVM_str_hash_next(hash,
+                    (MVMuint32)iter->body.hash_state.next) < hash->num_entries ? 1 : 0;
 
                 cur_op += 4;
                 goto NEXT;
@@ -5616,6 +5814,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 20;
                 goto NEXT;
             }
+#include "superops_interp.h"
 #if MVM_CGOTO
             OP_CALL_EXTOP: {
                 /* Bounds checking? Never heard of that. */
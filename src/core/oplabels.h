@@ -766,6 +766,33 @@ static const void * const LABELS[] = {
     &&OP_cpucores,
     &&OP_eqaticim_s,
     &&OP_indexicim_s,
+    &&OP_strbuilderappend_s,
+    &&OP_strbuilderappend_i,
+    &&OP_strbuilderappend_n,
+    &&OP_strbuilderappendcp,
+    &&OP_strbuilderchars,
+    &&OP_strbuilderfinish,
+    &&OP_cas_o,
+    &&OP_cas_i,
+    &&OP_atomicinc_i,
+    &&OP_atomicdec_i,
+    &&OP_atomicadd_i,
+    &&OP_atomicload_o,
+    &&OP_atomicload_i,
+    &&OP_atomicstore_o,
+    &&OP_atomicstore_i,
+    &&OP_casattr_o,
+    &&OP_atomicloadattr_o,
+    &&OP_atomicbindattr_o,
+    &&OP_caspos_o,
+    &&OP_atomicloadpos_o,
+    &&OP_atomicbindpos_o,
+    &&OP_barrierfull,
+    &&OP_queuepushbatch,
+    &&OP_queuepollbatch,
+    &&OP_schedulerstart,
+    &&OP_schedulersubmit,
+    &&OP_schedulerdepths,
     &&OP_sp_log,
     &&OP_sp_osrfinalize,
     &&OP_sp_guardconc,
@@ -811,6 +838,15 @@ static const void * const LABELS[] = {
     &&OP_sp_p6obind_i,
     &&OP_sp_p6obind_n,
     &&OP_sp_p6obind_s,
+    &&OP_sp_p6ocas_i,
+    &&OP_sp_p6oatomicinc_i,
+    &&OP_sp_p6oatomicdec_i,
+    &&OP_sp_p6oatomicadd_i,
+    &&OP_sp_p6oatomicload_i,
+    &&OP_sp_p6oatomicstore_i,
+    &&OP_sp_p6ocas_o,
+    &&OP_sp_p6oatomicload_o,
+    &&OP_sp_p6oatomicbind_o,
     &&OP_sp_deref_get_i64,
     &&OP_sp_deref_get_n,
     &&OP_sp_deref_bind_i64,
@@ -827,50 +863,14 @@ static const void * const LABELS[] = {
     &&OP_prof_allocated,
     &&OP_ctw_check,
     &&OP_coverage_log,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
+    &&OP_sp_fuse_const_i64_16_add_i,
+    &&OP_sp_fuse_decont_istype,
+    &&OP_sp_fuse_getattr_o_decont,
+    &&OP_sp_fuse_sp_p6oget_o_decont,
+    &&OP_sp_fuse_sp_getarg_o_sp_getarg_o,
+    &&OP_sp_fuse_const_i64_16_lt_i,
+    &&OP_sp_fuse_set_sp_p6oget_o,
+    &&OP_sp_fuse_sp_p6oget_o_sp_p6oget_o,
     NULL,
     NULL,
     NULL,
@@ -766,67 +766,111 @@
 #define MVM_OP_cpucores 762
 #define MVM_OP_eqaticim_s 763
 #define MVM_OP_indexicim_s 764
-#define MVM_OP_sp_log 765
-#define MVM_OP_sp_osrfinalize 766
-#define MVM_OP_sp_guardconc 767
-#define MVM_OP_sp_guardtype 768
-#define MVM_OP_sp_guardcontconc 769
-#define MVM_OP_sp_guardconttype 770
-#define MVM_OP_sp_guardrwconc 771
-#define MVM_OP_sp_guardrwtype 772
-#define MVM_OP_sp_getarg_o 773
-#define MVM_OP_sp_getarg_i 774
-#define MVM_OP_sp_getarg_n 775
-#define MVM_OP_sp_getarg_s 776
-#define MVM_OP_sp_fastinvoke_v 777
-#define MVM_OP_sp_fastinvoke_i 778
-#define MVM_OP_sp_fastinvoke_n 779
-#define MVM_OP_sp_fastinvoke_s 780
-#define MVM_OP_sp_fastinvoke_o 781
-#define MVM_OP_sp_namedarg_used 782
-#define MVM_OP_sp_getspeshslot 783
-#define MVM_OP_sp_findmeth 784
-#define MVM_OP_sp_fastcreate 785
-#define MVM_OP_sp_get_o 786
-#define MVM_OP_sp_get_i64 787
-#define MVM_OP_sp_get_i32 788
-#define MVM_OP_sp_get_i16 789
-#define MVM_OP_sp_get_i8 790
-#define MVM_OP_sp_get_n 791
-#define MVM_OP_sp_get_s 792
-#define MVM_OP_sp_bind_o 793
-#define MVM_OP_sp_bind_i64 794
-#define MVM_OP_sp_bind_i32 795
-#define MVM_OP_sp_bind_i16 796
-#define MVM_OP_sp_bind_i8 797
-#define MVM_OP_sp_bind_n 798
-#define MVM_OP_sp_bind_s 799
-#define MVM_OP_sp_p6oget_o 800
-#define MVM_OP_sp_p6ogetvt_o 801
-#define MVM_OP_sp_p6ogetvc_o 802
-#define MVM_OP_sp_p6oget_i 803
-#define MVM_OP_sp_p6oget_n 804
-#define MVM_OP_sp_p6oget_s 805
-#define MVM_OP_sp_p6obind_o 806
-#define MVM_OP_sp_p6obind_i 807
-#define MVM_OP_sp_p6obind_n 808
-#define MVM_OP_sp_p6obind_s 809
-#define MVM_OP_sp_deref_get_i64 810
-#define MVM_OP_sp_deref_get_n 811
-#define MVM_OP_sp_deref_bind_i64 812
-#define MVM_OP_sp_deref_bind_n 813
-#define MVM_OP_sp_jit_enter 814
-#define MVM_OP_sp_boolify_iter 815
-#define MVM_OP_sp_boolify_iter_arr 816
-#define MVM_OP_sp_boolify_iter_hash 817
-#define MVM_OP_prof_enter 818
-#define MVM_OP_prof_enterspesh 819
-#define MVM_OP_prof_enterinline 820
-#define MVM_OP_prof_enternative 821
-#define MVM_OP_prof_exit 822
-#define MVM_OP_prof_allocated 823
-#define MVM_OP_ctw_check 824
-#define MVM_OP_coverage_log 825
+#define MVM_OP_strbuilderappend_s 765
+#define MVM_OP_strbuilderappend_i 766
+#define MVM_OP_strbuilderappend_n 767
+#define MVM_OP_strbuilderappendcp 768
+#define MVM_OP_strbuilderchars 769
+#define MVM_OP_strbuilderfinish 770
+#define MVM_OP_cas_o 771
+#define MVM_OP_cas_i 772
+#define MVM_OP_atomicinc_i 773
+#define MVM_OP_atomicdec_i 774
+#define MVM_OP_atomicadd_i 775
+#define MVM_OP_atomicload_o 776
+#define MVM_OP_atomicload_i 777
+#define MVM_OP_atomicstore_o 778
+#define MVM_OP_atomicstore_i 779
+#define MVM_OP_casattr_o 780
+#define MVM_OP_atomicloadattr_o 781
+#define MVM_OP_atomicbindattr_o 782
+#define MVM_OP_caspos_o 783
+#define MVM_OP_atomicloadpos_o 784
+#define MVM_OP_atomicbindpos_o 785
+#define MVM_OP_barrierfull 786
+#define MVM_OP_queuepushbatch 787
+#define MVM_OP_queuepollbatch 788
+#define MVM_OP_schedulerstart 789
+#define MVM_OP_schedulersubmit 790
+#define MVM_OP_schedulerdepths 791
+#define MVM_OP_sp_log 792
+#define MVM_OP_sp_osrfinalize 793
+#define MVM_OP_sp_guardconc 794
+#define MVM_OP_sp_guardtype 795
+#define MVM_OP_sp_guardcontconc 796
+#define MVM_OP_sp_guardconttype 797
+#define MVM_OP_sp_guardrwconc 798
+#define MVM_OP_sp_guardrwtype 799
+#define MVM_OP_sp_getarg_o 800
+#define MVM_OP_sp_getarg_i 801
+#define MVM_OP_sp_getarg_n 802
+#define MVM_OP_sp_getarg_s 803
+#define MVM_OP_sp_fastinvoke_v 804
+#define MVM_OP_sp_fastinvoke_i 805
+#define MVM_OP_sp_fastinvoke_n 806
+#define MVM_OP_sp_fastinvoke_s 807
+#define MVM_OP_sp_fastinvoke_o 808
+#define MVM_OP_sp_namedarg_used 809
+#define MVM_OP_sp_getspeshslot 810
+#define MVM_OP_sp_findmeth 811
+#define MVM_OP_sp_fastcreate 812
+#define MVM_OP_sp_get_o 813
+#define MVM_OP_sp_get_i64 814
+#define MVM_OP_sp_get_i32 815
+#define MVM_OP_sp_get_i16 816
+#define MVM_OP_sp_get_i8 817
+#define MVM_OP_sp_get_n 818
+#define MVM_OP_sp_get_s 819
+#define MVM_OP_sp_bind_o 820
+#define MVM_OP_sp_bind_i64 821
+#define MVM_OP_sp_bind_i32 822
+#define MVM_OP_sp_bind_i16 823
+#define MVM_OP_sp_bind_i8 824
+#define MVM_OP_sp_bind_n 825
+#define MVM_OP_sp_bind_s 826
+#define MVM_OP_sp_p6oget_o 827
+#define MVM_OP_sp_p6ogetvt_o 828
+#define MVM_OP_sp_p6ogetvc_o 829
+#define MVM_OP_sp_p6oget_i 830
+#define MVM_OP_sp_p6oget_n 831
+#define MVM_OP_sp_p6oget_s 832
+#define MVM_OP_sp_p6obind_o 833
+#define MVM_OP_sp_p6obind_i 834
+#define MVM_OP_sp_p6obind_n 835
+#define MVM_OP_sp_p6obind_s 836
+#define MVM_OP_sp_p6ocas_i 837
+#define MVM_OP_sp_p6oatomicinc_i 838
+#define MVM_OP_sp_p6oatomicdec_i 839
+#define MVM_OP_sp_p6oatomicadd_i 840
+#define MVM_OP_sp_p6oatomicload_i 841
+#define MVM_OP_sp_p6oatomicstore_i 842
+#define MVM_OP_sp_p6ocas_o 843
+#define MVM_OP_sp_p6oatomicload_o 844
+#define MVM_OP_sp_p6oatomicbind_o 845
+#define MVM_OP_sp_deref_get_i64 846
+#define MVM_OP_sp_deref_get_n 847
+#define MVM_OP_sp_deref_bind_i64 848
+#define MVM_OP_sp_deref_bind_n 849
+#define MVM_OP_sp_jit_enter 850
+#define MVM_OP_sp_boolify_iter 851
+#define MVM_OP_sp_boolify_iter_arr 852
+#define MVM_OP_sp_boolify_iter_hash 853
+#define MVM_OP_prof_enter 854
+#define MVM_OP_prof_enterspesh 855
+#define MVM_OP_prof_enterinline 856
+#define MVM_OP_prof_enternative 857
+#define MVM_OP_prof_exit 858
+#define MVM_OP_prof_allocated 859
+#define MVM_OP_ctw_check 860
+#define MVM_OP_coverage_log 861
+#define MVM_OP_sp_fuse_const_i64_16_add_i 862
+#define MVM_OP_sp_fuse_decont_istype 863
+#define MVM_OP_sp_fuse_getattr_o_decont 864
+#define MVM_OP_sp_fuse_sp_p6oget_o_decont 865
+#define MVM_OP_sp_fuse_sp_getarg_o_sp_getarg_o 866
+#define MVM_OP_sp_fuse_const_i64_16_lt_i 867
+#define MVM_OP_sp_fuse_set_sp_p6oget_o 868
+#define MVM_OP_sp_fuse_sp_p6oget_o_sp_p6oget_o 869
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
@@ -0,0 +1,207 @@
+#include "moar.h"
+
+/* Number of entries we make space for when first adding to a table. */
+#define STR_HASH_MIN_ENTRIES 8
+
+MVM_STATIC_INLINE MVMuint32 key_hash(MVMThreadContext *tc, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return (MVMuint32)key->body.cached_hash_code;
+}
+
+MVM_STATIC_INLINE MVMStrHashSlot * get_slots(MVMStrHashTable *hash) {
+    return (MVMStrHashSlot *)(hash->entries + hash->alloc_entries);
+}
+
+/* Finds the slot referring to the entry with the given key, or NULL if there
+ * is no such entry. */
+static MVMStrHashSlot * find_slot(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key, MVMuint32 hash_val) {
+    MVMStrHashSlot *slots = get_slots(hash);
+    MVMuint32       mask  = 2 * hash->alloc_entries - 1;
+    MVMuint32       pos   = hash_val & mask;
+    while (slots[pos].index) {
+        if (slots[pos].hash == hash_val) {
+            MVMString *candidate = hash->entries[slots[pos].index - 1].key;
+            if (candidate == key || MVM_string_equal(tc, candidate, key))
+                return &slots[pos];
+        }
+        pos = (pos + 1) & mask;
+    }
+    return NULL;
+}
+
+/* Puts an entry in the first free slot starting from its hash. */
+MVM_STATIC_INLINE void insert_slot(MVMStrHashTable *hash, MVMuint32 hash_val, MVMuint32 index) {
+    MVMStrHashSlot *slots = get_slots(hash);
+    MVMuint32       mask  = 2 * hash->alloc_entries - 1;
+    MVMuint32       pos   = hash_val & mask;
+    while (slots[pos].index)
+        pos = (pos + 1) & mask;
+    slots[pos].hash  = hash_val;
+    slots[pos].index = index + 1;
+}
+
+/* Makes space for more entries. If a good number of those we have were
+ * deleted, we squeeze them out instead of growing. Either way the entries
+ * that remain keep their order. */
+static void grow(MVMThreadContext *tc, MVMStrHashTable *hash) {
+    MVMuint32        old_alloc   = hash->alloc_entries;
+    MVMStrHashEntry *old_entries = hash->entries;
+    MVMuint32        old_num     = hash->num_entries;
+    MVMuint32        new_alloc   = old_alloc == 0
+        ? STR_HASH_MIN_ENTRIES
+        : hash->num_items < old_alloc / 2 ? old_alloc : old_alloc * 2;
+    MVMuint32        i;
+
+    hash->entries       = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        MVM_STR_HASH_ALLOC_SIZE(new_alloc));
+    hash->alloc_entries = new_alloc;
+    hash->num_entries   = 0;
+    for (i = 0; i < old_num; i++) {
+        MVMString *key = old_entries[i].key;
+        if (key) {
+            hash->entries[hash->num_entries] = old_entries[i];
+            insert_slot(hash, key_hash(tc, key), hash->num_entries);
+            hash->num_entries++;
+        }
+    }
+
+    if (old_alloc)
+        MVM_fixed_size_free(tc, tc->instance->fsa, MVM_STR_HASH_ALLOC_SIZE(old_alloc),
+            old_entries);
+}
+
+/* Looks up the entry for the given key, returning NULL if there's none. The
+ * entry is only valid until the next time something is added to the table. */
+MVMStrHashEntry * MVM_str_hash_fetch(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key) {
+    MVMStrHashSlot *slot;
+    if (!hash->num_items)
+        return NULL;
+    slot = find_slot(tc, hash, key, key_hash(tc, key));
+    return slot ? &(hash->entries[slot->index - 1]) : NULL;
+}
+
+/* Looks up the entry for the given key, adding one with a NULL value if
+ * there's none. The caller is responsible for the write barrier on the key
+ * when adding to a table held by a collectable. */
+MVMStrHashEntry * MVM_str_hash_lvalue_fetch(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key) {
+    MVMuint32        hash_val = key_hash(tc, key);
+    MVMStrHashEntry *entry;
+    if (hash->num_items) {
+        MVMStrHashSlot *slot = find_slot(tc, hash, key, hash_val);
+        if (slot)
+            return &(hash->entries[slot->index - 1]);
+    }
+    if (hash->num_entries == hash->alloc_entries)
+        grow(tc, hash);
+    insert_slot(hash, hash_val, hash->num_entries);
+    entry        = &(hash->entries[hash->num_entries++]);
+    entry->key   = key;
+    entry->value = NULL;
+    hash->num_items++;
+    return entry;
+}
+
+/* Adds an entry with the given key and value, which the caller knows is not
+ * in the table, provided that can be done without growing it; returns NULL
+ * if not. Nothing already in the table moves, so this is safe while others
+ * read it without holding the caller's lock: the entry is written before
+ * the slot that refers to it, and it is only counted after that, so they
+ * see either all of it or none of it. The caller is responsible for the
+ * write barriers on the key and value. */
+MVMStrHashEntry * MVM_str_hash_append_in_place(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key, MVMObject *value) {
+    MVMuint32        hash_val = key_hash(tc, key);
+    MVMuint32        index    = hash->num_entries;
+    MVMStrHashSlot  *slots;
+    MVMStrHashEntry *entry;
+    MVMuint32        mask, pos;
+    if (index == hash->alloc_entries)
+        return NULL;
+
+    entry        = &(hash->entries[index]);
+    entry->key   = key;
+    entry->value = value;
+    MVM_barrier();
+
+    /* The hash goes in before the index, as a slot with an index is live. */
+    slots = get_slots(hash);
+    mask  = 2 * hash->alloc_entries - 1;
+    pos   = hash_val & mask;
+    while (slots[pos].index)
+        pos = (pos + 1) & mask;
+    slots[pos].hash = hash_val;
+    MVM_barrier();
+    slots[pos].index = index + 1;
+    MVM_barrier();
+
+    hash->num_entries = index + 1;
+    hash->num_items++;
+    return entry;
+}
+
+/* Deletes the entry with the given key, if there is one. */
+void MVM_str_hash_delete(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key) {
+    MVMStrHashSlot  *slots;
+    MVMStrHashSlot  *slot;
+    MVMStrHashEntry *entry;
+    MVMuint32        mask, pos, next;
+
+    if (!hash->num_items)
+        return;
+    slot = find_slot(tc, hash, key, key_hash(tc, key));
+    if (!slot)
+        return;
+
+    /* Mark the entry deleted, and drop it (and any deleted ones before it)
+     * off the end if it was the last one. */
+    entry        = &(hash->entries[slot->index - 1]);
+    entry->key   = NULL;
+    entry->value = NULL;
+    hash->num_items--;
+    while (hash->num_entries && !hash->entries[hash->num_entries - 1].key)
+        hash->num_entries--;
+
+    /* Empty the slot, moving back any later slots in the same run that
+     * would otherwise no longer be found from their starting position. */
+    slots = get_slots(hash);
+    mask  = 2 * hash->alloc_entries - 1;
+    pos   = slot - slots;
+    next  = (pos + 1) & mask;
+    while (slots[next].index) {
+        MVMuint32 home = slots[next].hash & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            slots[pos] = slots[next];
+            pos = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots[pos].index = 0;
+}
+
+/* Makes dest, which should be empty, a copy of src. The keys and values are
+ * shared, so the caller is responsible for any write barriers. */
+void MVM_str_hash_copy(MVMThreadContext *tc, MVMStrHashTable *dest, MVMStrHashTable *src) {
+    *dest = *src;
+    if (src->alloc_entries) {
+        size_t bytes  = MVM_STR_HASH_ALLOC_SIZE(src->alloc_entries);
+        dest->entries = MVM_fixed_size_alloc(tc, tc->instance->fsa, bytes);
+        memcpy(dest->entries, src->entries, bytes);
+    }
+}
+
+/* Frees the memory held by the table, leaving it empty. */
+void MVM_str_hash_demolish(MVMThreadContext *tc, MVMStrHashTable *hash) {
+    if (hash->alloc_entries)
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            MVM_STR_HASH_ALLOC_SIZE(hash->alloc_entries), hash->entries);
+    hash->entries       = NULL;
+    hash->num_entries   = 0;
+    hash->num_items     = 0;
+    hash->alloc_entries = 0;
+}
+
+/* Throws if the key isn't something we can look up in the table with. */
+void MVM_str_hash_check_key(MVMThreadContext *tc, MVMObject *key) {
+    if (MVM_is_null(tc, key) || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key))
+        MVM_exception_throw_adhoc(tc, "Hash keys must be concrete strings");
+}
@@ -0,0 +1,75 @@
+/* A hash table keyed on VM strings, used by the VMHash, HashAttrStore and
+ * ConcHash representations. Entries live inline in a single array, in the
+ * order they were added, so iterating is a linear walk and deleting an entry
+ * never moves any other. They are found through a power-of-two sized array
+ * of slots, each holding an entry's hash and index, using linear probing; the
+ * slots are kept at most half full, and the stored hash means a probe only
+ * touches an entry once the hashes match. An all-zero table is a valid empty
+ * one.
+ *
+ * Iterating is by position in the entries, so deleting (including the entry
+ * at the current position) is safe while iterating. Adding is not: when the
+ * entries are full, growing squeezes out the deleted ones, which moves those
+ * after them, so an iterator may then skip or repeat entries. As with the
+ * uthash tables this replaced, code that adds to a hash while iterating it
+ * gets no guarantees about which entries it sees. */
+struct MVMStrHashEntry {
+    /* The key, or NULL if this entry was deleted. */
+    MVMString *key;
+
+    /* The value; tables that map names to indexes, such as a static frame's
+     * lexical names, use index instead. */
+    union {
+        MVMObject *value;
+        MVMuint64  index;
+    };
+};
+
+struct MVMStrHashSlot {
+    /* The hash of the key in the entry. */
+    MVMuint32 hash;
+
+    /* One more than the index of the entry, or zero if the slot is empty. */
+    MVMuint32 index;
+};
+
+struct MVMStrHashTable {
+    /* The entries, followed in the same allocation by the slots. */
+    MVMStrHashEntry *entries;
+
+    /* The number of entries in use, including deleted ones. */
+    MVMuint32 num_entries;
+
+    /* The number of entries not deleted. */
+    MVMuint32 num_items;
+
+    /* The number of entries there's space for; there are twice as many
+     * slots. Zero if nothing was allocated yet. */
+    MVMuint32 alloc_entries;
+};
+
+MVMStrHashEntry * MVM_str_hash_fetch(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key);
+MVMStrHashEntry * MVM_str_hash_lvalue_fetch(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key);
+MVMStrHashEntry * MVM_str_hash_append_in_place(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key, MVMObject *value);
+void MVM_str_hash_delete(MVMThreadContext *tc, MVMStrHashTable *hash, MVMString *key);
+void MVM_str_hash_copy(MVMThreadContext *tc, MVMStrHashTable *dest, MVMStrHashTable *src);
+void MVM_str_hash_demolish(MVMThreadContext *tc, MVMStrHashTable *hash);
+void MVM_str_hash_check_key(MVMThreadContext *tc, MVMObject *key);
+
+/* Returns the position of the first entry at or after pos that is not
+ * deleted, or num_entries if there is none. Iterate with:
+ *     for (i = MVM_str_hash_next(hash, 0); i < hash->num_entries; i = MVM_str_hash_next(hash, i + 1))
+ */
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_next(MVMStrHashTable *hash, MVMuint32 pos) {
+    while (pos < hash->num_entries && !hash->entries[pos].key)
+        pos++;
+    return pos;
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_count(MVMStrHashTable *hash) {
+    return hash->num_items;
+}
+
+/* Bytes allocated for a table with space for the given number of entries. */
+#define MVM_STR_HASH_ALLOC_SIZE(alloc_entries) \
+    ((alloc_entries) * (sizeof(MVMStrHashEntry) + 2 * sizeof(MVMStrHashSlot)))
@@ -0,0 +1,57 @@
+/* This file is generated by tools/gen_superops.pl; do not edit by hand. */
+
+/* Gets the superinstruction that fuses the two ops, or zero if there is
+ * none. */
+MVM_STATIC_INLINE MVMuint16 MVM_superop_for(MVMuint16 first, MVMuint16 second) {
+    switch (first) {
+        case MVM_OP_const_i64_16:
+            switch (second) {
+                case MVM_OP_add_i: return MVM_OP_sp_fuse_const_i64_16_add_i;
+                case MVM_OP_lt_i: return MVM_OP_sp_fuse_const_i64_16_lt_i;
+            }
+            break;
+        case MVM_OP_decont:
+            switch (second) {
+                case MVM_OP_istype: return MVM_OP_sp_fuse_decont_istype;
+            }
+            break;
+        case MVM_OP_getattr_o:
+            switch (second) {
+                case MVM_OP_decont: return MVM_OP_sp_fuse_getattr_o_decont;
+            }
+            break;
+        case MVM_OP_set:
+            switch (second) {
+                case MVM_OP_sp_p6oget_o: return MVM_OP_sp_fuse_set_sp_p6oget_o;
+            }
+            break;
+        case MVM_OP_sp_getarg_o:
+            switch (second) {
+                case MVM_OP_sp_getarg_o: return MVM_OP_sp_fuse_sp_getarg_o_sp_getarg_o;
+            }
+            break;
+        case MVM_OP_sp_p6oget_o:
+            switch (second) {
+                case MVM_OP_decont: return MVM_OP_sp_fuse_sp_p6oget_o_decont;
+                case MVM_OP_sp_p6oget_o: return MVM_OP_sp_fuse_sp_p6oget_o_sp_p6oget_o;
+            }
+            break;
+    }
+    return 0;
+}
+
+/* Maps a superinstruction back to the first op it fuses; other ops are
+ * returned unchanged. */
+MVM_STATIC_INLINE MVMuint16 MVM_superop_unfuse(MVMuint16 op) {
+    switch (op) {
+        case MVM_OP_sp_fuse_const_i64_16_add_i: return MVM_OP_const_i64_16;
+        case MVM_OP_sp_fuse_decont_istype: return MVM_OP_decont;
+        case MVM_OP_sp_fuse_getattr_o_decont: return MVM_OP_getattr_o;
+        case MVM_OP_sp_fuse_sp_p6oget_o_decont: return MVM_OP_sp_p6oget_o;
+        case MVM_OP_sp_fuse_sp_getarg_o_sp_getarg_o: return MVM_OP_sp_getarg_o;
+        case MVM_OP_sp_fuse_const_i64_16_lt_i: return MVM_OP_const_i64_16;
+        case MVM_OP_sp_fuse_set_sp_p6oget_o: return MVM_OP_set;
+        case MVM_OP_sp_fuse_sp_p6oget_o_sp_p6oget_o: return MVM_OP_sp_p6oget_o;
+        default: return op;
+    }
+}
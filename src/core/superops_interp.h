@@ -0,0 +1,162 @@
+/* This file is generated by tools/gen_superops.pl from the op bodies in
+ * interp.c; do not edit by hand. It is included in the interpreter's
+ * dispatch. */
+            OP(sp_fuse_const_i64_16_add_i): {
+                MVMuint8 *fuse_next = cur_op + 4;
+                GET_REG(cur_op, 0).i64 = GET_I16(cur_op, 2);
+                cur_op += 4;
+                goto sp_fuse_const_i64_16_add_i_second;
+              sp_fuse_const_i64_16_add_i_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                GET_REG(cur_op, 0).i64 = GET_REG(cur_op, 2).i64 + GET_REG(cur_op, 4).i64;
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_fuse_decont_istype): {
+                MVMuint8 *fuse_next = cur_op + 4;
+                {
+                    MVMObject *obj = GET_REG(cur_op, 2).o;
+                    MVMRegister *r = &GET_REG(cur_op, 0);
+                    cur_op += 4;
+                    if (obj && IS_CONCRETE(obj) && STABLE(obj)->container_spec)
+                        STABLE(obj)->container_spec->fetch(tc, obj, r);
+                    else
+                        r->o = obj;
+                    goto sp_fuse_decont_istype_second;
+                }
+              sp_fuse_decont_istype_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                {
+                    /* Increment PC first, as we may make a method call. */
+                    MVMRegister *res  = &GET_REG(cur_op, 0);
+                    MVMObject   *obj  = GET_REG(cur_op, 2).o;
+                    MVMObject   *type = GET_REG(cur_op, 4).o;
+                    cur_op += 6;
+                    MVM_6model_istype(tc, obj, type, res);
+                    goto NEXT;
+                }
+            }
+            OP(sp_fuse_getattr_o_decont): {
+                MVMuint8 *fuse_next = cur_op + 12;
+                {
+                    MVMObject *obj = GET_REG(cur_op, 2).o;
+                    if (!IS_CONCRETE(obj))
+                        MVM_exception_throw_adhoc(tc, "Cannot look up attributes in a %s type object", STABLE(obj)->debug_name);
+                    REPR(obj)->attr_funcs.get_attribute(tc,
+                        STABLE(obj), obj, OBJECT_BODY(obj),
+                        GET_REG(cur_op, 4).o, MVM_cu_string(tc, cu, GET_UI32(cur_op, 6)),
+                        GET_I16(cur_op, 10), &GET_REG(cur_op, 0), MVM_reg_obj);
+                    cur_op += 12;
+                    goto sp_fuse_getattr_o_decont_second;
+                }
+              sp_fuse_getattr_o_decont_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                {
+                    MVMObject *obj = GET_REG(cur_op, 2).o;
+                    MVMRegister *r = &GET_REG(cur_op, 0);
+                    cur_op += 4;
+                    if (obj && IS_CONCRETE(obj) && STABLE(obj)->container_spec)
+                        STABLE(obj)->container_spec->fetch(tc, obj, r);
+                    else
+                        r->o = obj;
+                    goto NEXT;
+                }
+            }
+            OP(sp_fuse_sp_p6oget_o_decont): {
+                MVMuint8 *fuse_next = cur_op + 6;
+                {
+                    MVMObject *o     = GET_REG(cur_op, 2).o;
+                    char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                    MVMObject *val   = *((MVMObject **)(data + GET_UI16(cur_op, 4)));
+                    GET_REG(cur_op, 0).o = val ? val : tc->instance->VMNull;
+                    cur_op += 6;
+                    goto sp_fuse_sp_p6oget_o_decont_second;
+                }
+              sp_fuse_sp_p6oget_o_decont_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                {
+                    MVMObject *obj = GET_REG(cur_op, 2).o;
+                    MVMRegister *r = &GET_REG(cur_op, 0);
+                    cur_op += 4;
+                    if (obj && IS_CONCRETE(obj) && STABLE(obj)->container_spec)
+                        STABLE(obj)->container_spec->fetch(tc, obj, r);
+                    else
+                        r->o = obj;
+                    goto NEXT;
+                }
+            }
+            OP(sp_fuse_sp_getarg_o_sp_getarg_o): {
+                MVMuint8 *fuse_next = cur_op + 4;
+                GET_REG(cur_op, 0).o = tc->cur_frame->params.args[GET_UI16(cur_op, 2)].o;
+                cur_op += 4;
+                goto sp_fuse_sp_getarg_o_sp_getarg_o_second;
+              sp_fuse_sp_getarg_o_sp_getarg_o_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                GET_REG(cur_op, 0).o = tc->cur_frame->params.args[GET_UI16(cur_op, 2)].o;
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sp_fuse_const_i64_16_lt_i): {
+                MVMuint8 *fuse_next = cur_op + 4;
+                GET_REG(cur_op, 0).i64 = GET_I16(cur_op, 2);
+                cur_op += 4;
+                goto sp_fuse_const_i64_16_lt_i_second;
+              sp_fuse_const_i64_16_lt_i_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                GET_REG(cur_op, 0).i64 = GET_REG(cur_op, 2).i64 <  GET_REG(cur_op, 4).i64;
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_fuse_set_sp_p6oget_o): {
+                MVMuint8 *fuse_next = cur_op + 4;
+                GET_REG(cur_op, 0) = GET_REG(cur_op, 2);
+                cur_op += 4;
+                goto sp_fuse_set_sp_p6oget_o_second;
+              sp_fuse_set_sp_p6oget_o_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                {
+                    MVMObject *o     = GET_REG(cur_op, 2).o;
+                    char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                    MVMObject *val   = *((MVMObject **)(data + GET_UI16(cur_op, 4)));
+                    GET_REG(cur_op, 0).o = val ? val : tc->instance->VMNull;
+                    cur_op += 6;
+                    goto NEXT;
+                }
+            }
+            OP(sp_fuse_sp_p6oget_o_sp_p6oget_o): {
+                MVMuint8 *fuse_next = cur_op + 6;
+                {
+                    MVMObject *o     = GET_REG(cur_op, 2).o;
+                    char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                    MVMObject *val   = *((MVMObject **)(data + GET_UI16(cur_op, 4)));
+                    GET_REG(cur_op, 0).o = val ? val : tc->instance->VMNull;
+                    cur_op += 6;
+                    goto sp_fuse_sp_p6oget_o_sp_p6oget_o_second;
+                }
+              sp_fuse_sp_p6oget_o_sp_p6oget_o_second:
+                if (cur_op != fuse_next)
+                    goto NEXT;
+                cur_op += 2;
+                {
+                    MVMObject *o     = GET_REG(cur_op, 2).o;
+                    char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                    MVMObject *val   = *((MVMObject **)(data + GET_UI16(cur_op, 4)));
+                    GET_REG(cur_op, 0).o = val ? val : tc->instance->VMNull;
+                    cur_op += 6;
+                    goto NEXT;
+                }
+            }
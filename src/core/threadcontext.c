@@ -47,6 +47,9 @@ MVMThreadContext * MVM_tc_create(MVMThreadContext *parent, MVMInstance *instance
     /* The fixed size allocator also keeps pre-thread state. */
     MVM_fixed_size_create_thread(tc);
 
+    /* Set up the cache of recently used NFG synthetics. */
+    tc->nfg_cache = MVM_calloc(MVM_NFG_CACHE_SIZE, sizeof(MVMint32));
+
     /* Allocate an initial call stack region for the thread. */
     MVM_callstack_region_init(tc);
 
@@ -101,6 +104,9 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
     MVM_free(tc->nfa_longlit);
     MVM_free(tc->multi_dim_indices);
 
+    /* Free the NFG synthetics cache. */
+    MVM_free(tc->nfg_cache);
+
     /* Free per-thread lexotic cache. */
     MVM_free(tc->lexotic_cache);
 
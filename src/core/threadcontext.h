@@ -175,6 +175,11 @@ struct MVMThreadContext {
     MVMObject     *cur_dispatcher;
     MVMObject     *cur_dispatcher_for;
 
+    /* If this thread is a worker of a ConcScheduler, the scheduler and which
+     * of its workers this is. Tasks the worker submits go on its own deque. */
+    MVMObject     *scheduler;
+    MVMuint32      scheduler_worker;
+
     /* Cache of native code callback data. */
     MVMNativeCallbackCacheHead *native_callback_cache;
 
@@ -196,6 +201,10 @@ struct MVMThreadContext {
     MVMint64 *nfa_longlit;
     MVMint64  nfa_longlit_len;
 
+    /* Recently looked up NFG synthetics, indexed by a hash of their
+     * codepoints; see nfg.c. */
+    MVMint32 *nfg_cache;
+
     /* Memory for doing multi-dim indexing with late-bound dimension counts. */
     MVMint64 *multi_dim_indices;
     MVMint64  num_multi_dim_indices;
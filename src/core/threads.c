@@ -1,10 +1,13 @@
 #include "moar.h"
 #include <platform/threads.h>
 
-/* Temporary structure for passing data to thread start. */
+/* Temporary structure for passing data to thread start. If body is set, the
+ * thread runs that C function rather than invoking the thread's invokee. */
 typedef struct {
     MVMThreadContext *tc;
     MVMObject        *thread_obj;
+    void            (*body)(MVMThreadContext *tc, void *data);
+    void             *body_data;
 } ThreadStart;
 
 /* Creates a new thread handle with the MVMThread representation. Does not
@@ -81,8 +84,12 @@ static void start_thread(void *data) {
     MVM_gc_mark_thread_unblocked(tc);
     tc->thread_obj->body.stage = MVM_thread_stage_started;
 
-    /* Enter the interpreter, to run code. */
-    MVM_interp_run(tc, thread_initial_invoke, ts);
+    /* Enter the interpreter, to run code, or run the native body, which
+     * will do so itself as needed. */
+    if (ts->body)
+        ts->body(tc, ts->body_data);
+    else
+        MVM_interp_run(tc, thread_initial_invoke, ts);
 
     /* Pop the temp root stack's ts->thread_obj, if it's still there (if we
      * cleared the temp root stack on exception at some point, it'll already be
@@ -102,8 +109,10 @@ static void start_thread(void *data) {
     MVM_platform_thread_exit(NULL);
 }
 
-/* Begins execution of a thread. */
-void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread_obj) {
+/* Begins execution of a thread, either invoking its invokee or running the
+ * given native body. */
+static void run_thread(MVMThreadContext *tc, MVMObject *thread_obj,
+        void (*body)(MVMThreadContext *tc, void *data), void *body_data) {
     MVMThread *child = (MVMThread *)thread_obj;
     int status;
     ThreadStart *ts;
@@ -119,6 +128,8 @@ void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread_obj) {
         ts = MVM_malloc(sizeof(ThreadStart));
         ts->tc = child_tc;
         ts->thread_obj = thread_obj;
+        ts->body = body;
+        ts->body_data = body_data;
 
         /* Push this to the *child* tc's temp roots. */
         MVM_gc_root_temp_push(child_tc, (MVMCollectable **)&ts->thread_obj);
@@ -144,6 +155,18 @@ void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread_obj) {
     }
 }
 
+void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread_obj) {
+    run_thread(tc, thread_obj, NULL, NULL);
+}
+
+/* Begins execution of a thread that runs a C function instead of invoking
+ * its invokee. The function may enter the interpreter any number of times
+ * itself, and the thread exits when it returns. */
+void MVM_thread_run_native(MVMThreadContext *tc, MVMObject *thread_obj,
+        void (*body)(MVMThreadContext *tc, void *data), void *body_data) {
+    run_thread(tc, thread_obj, body, body_data);
+}
+
 /* Waits for a thread to finish. */
 static int try_join(MVMThreadContext *tc, MVMThread *thread) {
     /* Join the thread, marking ourselves as unable to GC while we wait. */
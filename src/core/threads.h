@@ -1,5 +1,7 @@
 MVMObject * MVM_thread_new(MVMThreadContext *tc, MVMObject *invokee, MVMint64 app_lifetime);
 void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread);
+void MVM_thread_run_native(MVMThreadContext *tc, MVMObject *thread,
+    void (*body)(MVMThreadContext *tc, void *data), void *body_data);
 void MVM_thread_join(MVMThreadContext *tc, MVMObject *thread);
 MVMint64 MVM_thread_id(MVMThreadContext *tc, MVMObject *thread);
 MVMint64 MVM_thread_native_id(MVMThreadContext *tc, MVMObject *thread);
@@ -53,6 +53,9 @@ typedef struct {
     MVMuint16         remaining_positionals;
     MVMuint32         remaining_jumplabels;
     MVMuint32         reg_type_var;
+    MVMuint32         num_meth_sites;
+    MVMuint32         last_meth_site;
+    MVMuint32         min_meth_site_distance;
 } Validator;
 
 
@@ -164,6 +167,19 @@ MVM_string_print(val->tc, val->cu->body.filename);
 printf(" %u %s %.2s\n", val->cur_instr, info->name, info->mark);
 #endif
 
+    /* Note method lookup sites, so we can size the inline cache. */
+    if (opcode == MVM_OP_findmeth || opcode == MVM_OP_findmeth_s) {
+        if (val->num_meth_sites == 0) {
+            val->num_meth_sites = 1;
+        }
+        else if (pos != val->last_meth_site) {
+            if (pos - val->last_meth_site < val->min_meth_site_distance)
+                val->min_meth_site_distance = pos - val->last_meth_site;
+            val->num_meth_sites++;
+        }
+        val->last_meth_site = pos;
+    }
+
     val->labels[pos] |= MVM_BC_op_boundary;
     val->cur_info     = info;
     val->cur_mark     = info->mark;
@@ -669,6 +685,10 @@ void MVM_validate_static_frame(MVMThreadContext *tc,
     val->remaining_jumplabels  = 0;
     val->reg_type_var          = 0;
 
+    val->num_meth_sites         = 0;
+    val->last_meth_site         = 0;
+    val->min_meth_site_distance = fb->bytecode_size;
+
 #ifdef MVM_BIGENDIAN
     assert(fb->bytecode == fb->orig_bytecode);
     val->bc_start = MVM_malloc(fb->bytecode_size);
@@ -709,4 +729,9 @@ void MVM_validate_static_frame(MVMThreadContext *tc,
 
     /* Validation successful. Clear up instruction offsets. */
     MVM_free(val->labels);
+
+    /* Set up inline caches for any method lookup sites. */
+    if (val->num_meth_sites)
+        MVM_inline_cache_setup(tc, &(fb->inline_cache), fb->bytecode,
+            fb->bytecode_size, val->min_meth_site_distance);
 }
@@ -162,6 +162,9 @@ void MVM_gc_root_add_tc_roots_to_worklist(MVMThreadContext *tc, MVMGCWorklist *w
     add_collectable(tc, worklist, snapshot, tc->cur_dispatcher, "Current dispatcher");
     add_collectable(tc, worklist, snapshot, tc->cur_dispatcher_for, "Current dispatcher for");
 
+    /* Scheduler this thread is a worker for. */
+    add_collectable(tc, worklist, snapshot, tc->scheduler, "Worker scheduler");
+
     /* Callback cache. */
     HASH_ITER(hash_handle, tc->native_callback_cache, current_cbceh, tmp_cbceh, bucket_tmp) {
         MVMint32 i;
@@ -378,8 +381,11 @@ void MVM_gc_root_add_frame_roots_to_worklist(MVMThreadContext *tc, MVMGCWorklist
     }
 
     /* Mark any dyn lex cache. */
-    if (cur_frame->dynlex_cache_name)
-        MVM_gc_worklist_add(tc, worklist, &cur_frame->dynlex_cache_name);
+    if (cur_frame->dynlex_cache) {
+        MVMuint32 i;
+        for (i = 0; i < MVM_DYNLEX_CACHE_SIZE; i++)
+            MVM_gc_worklist_add(tc, worklist, &cur_frame->dynlex_cache->entries[i].name);
+    }
 
     /* Scan the registers. */
     MVM_gc_root_add_frame_registers_to_worklist(tc, worklist, cur_frame);
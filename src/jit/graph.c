@@ -307,6 +307,32 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_encode: return MVM_string_encode_to_buf;
     case MVM_OP_decoderaddbytes: return MVM_decoder_add_bytes;
     case MVM_OP_decodertakeline: return MVM_decoder_take_line;
+    case MVM_OP_strbuilderappend_s: return MVM_string_builder_append_str;
+    case MVM_OP_strbuilderappend_i: return MVM_string_builder_append_int;
+    case MVM_OP_strbuilderappend_n: return MVM_string_builder_append_num;
+    case MVM_OP_strbuilderappendcp: return MVM_string_builder_append_codepoint;
+    case MVM_OP_strbuilderchars: return MVM_string_builder_chars;
+    case MVM_OP_strbuilderfinish: return MVM_string_builder_finish;
+    case MVM_OP_cas_o: return MVM_6model_container_cas;
+    case MVM_OP_cas_i: return MVM_6model_container_cas_i;
+    case MVM_OP_atomicinc_i: return MVM_6model_container_atomic_inc;
+    case MVM_OP_atomicdec_i: return MVM_6model_container_atomic_dec;
+    case MVM_OP_atomicadd_i: return MVM_6model_container_atomic_add;
+    case MVM_OP_atomicload_o: return MVM_6model_container_atomic_load;
+    case MVM_OP_atomicload_i: return MVM_6model_container_atomic_load_i;
+    case MVM_OP_atomicstore_o: return MVM_6model_container_atomic_store;
+    case MVM_OP_atomicstore_i: return MVM_6model_container_atomic_store_i;
+    case MVM_OP_casattr_o: return MVM_repr_cas_attr_o;
+    case MVM_OP_atomicloadattr_o: return MVM_repr_atomic_load_attr_o;
+    case MVM_OP_atomicbindattr_o: return MVM_repr_atomic_bind_attr_o;
+    case MVM_OP_caspos_o: return MVM_repr_cas_pos_o;
+    case MVM_OP_atomicloadpos_o: return MVM_repr_atomic_load_pos_o;
+    case MVM_OP_atomicbindpos_o: return MVM_repr_atomic_bind_pos_o;
+    case MVM_OP_sp_p6ocas_o: return MVM_p6opaque_atomic_cas_o;
+    case MVM_OP_sp_p6oatomicload_o: return MVM_p6opaque_atomic_load_o;
+    case MVM_OP_sp_p6oatomicbind_o: return MVM_p6opaque_atomic_bind_o;
+    case MVM_OP_queuepushbatch: return MVM_concblockingqueue_push_batch;
+    case MVM_OP_queuepollbatch: return MVM_concblockingqueue_poll_batch;
 
     case MVM_OP_elems: return MVM_repr_elems;
     case MVM_OP_concat_s: return MVM_string_concatenate;
@@ -1548,6 +1574,13 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
     case MVM_OP_sp_p6obind_n:
     case MVM_OP_sp_p6obind_s:
     case MVM_OP_sp_p6obind_o:
+    case MVM_OP_sp_p6ocas_i:
+    case MVM_OP_sp_p6oatomicinc_i:
+    case MVM_OP_sp_p6oatomicdec_i:
+    case MVM_OP_sp_p6oatomicadd_i:
+    case MVM_OP_sp_p6oatomicload_i:
+    case MVM_OP_sp_p6oatomicstore_i:
+    case MVM_OP_barrierfull:
     case MVM_OP_sp_bind_i64:
     case MVM_OP_sp_bind_n:
     case MVM_OP_sp_bind_s:
@@ -2455,6 +2488,206 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
         jgb_append_call_c(tc, jgb, &MVM_decoder_ensure_decoder, 3, argc, MVM_JIT_RV_VOID, -1);
         jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args, MVM_JIT_RV_PTR, dst);
         break;
+    }
+    case MVM_OP_strbuilderappend_s:
+    case MVM_OP_strbuilderappend_i:
+    case MVM_OP_strbuilderappend_n:
+    case MVM_OP_strbuilderappendcp: {
+        MVMint16 sb    = ins->operands[0].reg.orig;
+        MVMint16 value = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } },
+                                 { op == MVM_OP_strbuilderappend_n ? MVM_JIT_REG_VAL_F : MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_strbuilderchars:
+    case MVM_OP_strbuilderfinish: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 sb  = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 2, args,
+            op == MVM_OP_strbuilderchars ? MVM_JIT_RV_INT : MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_cas_o:
+    case MVM_OP_cas_i: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 cont     = ins->operands[1].reg.orig;
+        MVMint16 expected = ins->operands[2].reg.orig;
+        MVMint16 value    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cont } },
+                                 { MVM_JIT_REG_VAL, { expected } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args,
+            op == MVM_OP_cas_i ? MVM_JIT_RV_INT : MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_atomicinc_i:
+    case MVM_OP_atomicdec_i:
+    case MVM_OP_atomicload_i:
+    case MVM_OP_atomicload_o: {
+        MVMint16 dst  = ins->operands[0].reg.orig;
+        MVMint16 cont = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cont } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 2, args,
+            op == MVM_OP_atomicload_o ? MVM_JIT_RV_PTR : MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_atomicadd_i: {
+        MVMint16 dst   = ins->operands[0].reg.orig;
+        MVMint16 cont  = ins->operands[1].reg.orig;
+        MVMint16 value = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cont } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_atomicstore_o:
+    case MVM_OP_atomicstore_i: {
+        MVMint16 cont  = ins->operands[0].reg.orig;
+        MVMint16 value = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cont } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_casattr_o: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 obj      = ins->operands[1].reg.orig;
+        MVMint16 type     = ins->operands[2].reg.orig;
+        MVMint16 name     = ins->operands[3].reg.orig;
+        MVMint16 expected = ins->operands[4].reg.orig;
+        MVMint16 value    = ins->operands[5].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { type } },
+                                 { MVM_JIT_REG_VAL, { name } },
+                                 { MVM_JIT_REG_VAL, { expected } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 6, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_atomicloadattr_o: {
+        MVMint16 dst  = ins->operands[0].reg.orig;
+        MVMint16 obj  = ins->operands[1].reg.orig;
+        MVMint16 type = ins->operands[2].reg.orig;
+        MVMint16 name = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { type } },
+                                 { MVM_JIT_REG_VAL, { name } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_atomicbindattr_o: {
+        MVMint16 obj   = ins->operands[0].reg.orig;
+        MVMint16 type  = ins->operands[1].reg.orig;
+        MVMint16 name  = ins->operands[2].reg.orig;
+        MVMint16 value = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { type } },
+                                 { MVM_JIT_REG_VAL, { name } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_caspos_o: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 obj      = ins->operands[1].reg.orig;
+        MVMint16 idx      = ins->operands[2].reg.orig;
+        MVMint16 expected = ins->operands[3].reg.orig;
+        MVMint16 value    = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { idx } },
+                                 { MVM_JIT_REG_VAL, { expected } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 5, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_atomicloadpos_o: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 obj = ins->operands[1].reg.orig;
+        MVMint16 idx = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { idx } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_atomicbindpos_o: {
+        MVMint16 obj   = ins->operands[0].reg.orig;
+        MVMint16 idx   = ins->operands[1].reg.orig;
+        MVMint16 value = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_REG_VAL, { idx } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_sp_p6ocas_o: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 obj      = ins->operands[1].reg.orig;
+        MVMuint16 offset  = ins->operands[2].lit_i16;
+        MVMint16 expected = ins->operands[3].reg.orig;
+        MVMint16 value    = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_LITERAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { expected } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 5, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_sp_p6oatomicload_o: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 obj     = ins->operands[1].reg.orig;
+        MVMuint16 offset = ins->operands[2].lit_i16;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_LITERAL, { offset } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_sp_p6oatomicbind_o: {
+        MVMint16 obj     = ins->operands[0].reg.orig;
+        MVMuint16 offset = ins->operands[1].lit_i16;
+        MVMint16 value   = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_LITERAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_queuepushbatch: {
+        MVMint16 queue  = ins->operands[0].reg.orig;
+        MVMint16 values = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { queue } },
+                                 { MVM_JIT_REG_VAL, { values } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_queuepollbatch: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 queue  = ins->operands[1].reg.orig;
+        MVMint16 target = ins->operands[2].reg.orig;
+        MVMint16 max    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { queue } },
+                                 { MVM_JIT_REG_VAL, { target } },
+                                 { MVM_JIT_REG_VAL, { max } } };
+        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
     }
         /* bigint ops */
     case MVM_OP_isbig_I: {
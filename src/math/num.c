@@ -43,3 +43,330 @@ MVMnum64 MVM_num_neginf(MVMThreadContext *tc) {
 MVMnum64 MVM_num_nan(MVMThreadContext *tc) {
     return MVM_NUM_NAN;
 }
+
+/* Finds the shortest string of decimal digits that reads back as the given
+ * number, using Florian Loitsch's Grisu3 algorithm. The number is
+ * approximated by a 64-bit significand and binary exponent, scaled by a
+ * cached power of ten so the digits can be produced with integer
+ * arithmetic, and digits are generated until we are inside the interval of
+ * values that round to the number. Grisu3 keeps track of the error in the
+ * approximation, and for the few numbers (around 0.5%) where that leaves it
+ * unsure its digits are the shortest and closest, we instead take Grisu2's
+ * digits, which always round trip but may be a digit long, and try to
+ * shorten them. */
+typedef struct {
+    MVMuint64 f;
+    MVMint32  e;
+} DiyFp;
+
+/* Normalized approximations of 10^k for k = -348, -340, ..., 340. */
+static const MVMuint64 cached_powers_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+static const MVMint16 cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const MVMuint64 pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+#define DP_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define DP_HIDDEN_BIT       0x0010000000000000ULL
+#define DP_EXPONENT_MASK    0x7FF0000000000000ULL
+
+static DiyFp diyfp_multiply(DiyFp x, DiyFp y) {
+    MVMuint64 M32 = 0xFFFFFFFFULL;
+    MVMuint64 a   = x.f >> 32, b = x.f & M32;
+    MVMuint64 c   = y.f >> 32, d = y.f & M32;
+    MVMuint64 ac  = a * c, bc = b * c, ad = a * d, bd = b * d;
+    MVMuint64 tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    DiyFp     r;
+    tmp += 1ULL << 31; /* Round. */
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static DiyFp diyfp_normalize(DiyFp x) {
+    while (!(x.f & (1ULL << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/* Gets the cached power c = 10^-K such that multiplying a number with the
+ * binary exponent e by it gives an exponent in the range we want. */
+static DiyFp cached_power(MVMint32 e, MVMint32 *K) {
+    double    dk = (-61 - e) * 0.30102999566398114 + 347;
+    MVMint32  k  = (MVMint32)dk;
+    MVMuint32 index;
+    DiyFp     c;
+    if (dk - k > 0.0)
+        k++;
+    index = (MVMuint32)((k >> 3) + 1);
+    *K    = -(-348 + (MVMint32)(index << 3));
+    c.f   = cached_powers_f[index];
+    c.e   = cached_powers_e[index];
+    return c;
+}
+
+static MVMint32 count_decimal_digits(MVMuint32 n) {
+    MVMint32 digits = 1;
+    while (digits < 10 && n >= pow10_u64[digits])
+        digits++;
+    return digits;
+}
+
+/* Moves the last digit down while that gets us closer to the number, and
+ * still within the interval. */
+static void grisu_round(char *buffer, MVMint32 len, MVMuint64 delta, MVMuint64 rest,
+        MVMuint64 ten_kappa, MVMuint64 wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+            (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static MVMint32 digit_gen(DiyFp W, DiyFp Mp, MVMuint64 delta, char *buffer, MVMint32 *K) {
+    MVMint32  shift = -Mp.e;
+    MVMuint64 one   = 1ULL << shift;
+    MVMuint64 wp_w  = Mp.f - W.f;
+    MVMuint32 p1    = (MVMuint32)(Mp.f >> shift);
+    MVMuint64 p2    = Mp.f & (one - 1);
+    MVMint32  kappa = count_decimal_digits(p1);
+    MVMint32  len   = 0;
+
+    while (kappa > 0) {
+        MVMuint32 d = (MVMuint32)(p1 / pow10_u64[kappa - 1]);
+        MVMuint64 rest;
+        p1 %= (MVMuint32)pow10_u64[kappa - 1];
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        kappa--;
+        rest = ((MVMuint64)p1 << shift) + p2;
+        if (rest <= delta) {
+            *K += kappa;
+            grisu_round(buffer, len, delta, rest, pow10_u64[kappa] << shift, wp_w);
+            return len;
+        }
+    }
+
+    while (1) {
+        char d;
+        p2    *= 10;
+        delta *= 10;
+        d      = (char)(p2 >> shift);
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisu_round(buffer, len, delta, p2, one,
+                -kappa < 20 ? wp_w * pow10_u64[-kappa] : 0);
+            return len;
+        }
+    }
+}
+
+/* Moves the last digit of Grisu3's result down while that gets it closer to
+ * the number, then checks that the result is certain to be the closest and
+ * within the interval, given that each of the scaled values may be out by up
+ * to unit. Returns 0 if not. */
+static int grisu3_round_weed(char *buffer, MVMint32 len, MVMuint64 distance_too_high_w,
+        MVMuint64 unsafe_interval, MVMuint64 rest, MVMuint64 ten_kappa, MVMuint64 unit) {
+    MVMuint64 small_distance = distance_too_high_w - unit;
+    MVMuint64 big_distance   = distance_too_high_w + unit;
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+            (rest + ten_kappa < small_distance ||
+             small_distance - rest >= rest + ten_kappa - small_distance)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+            (rest + ten_kappa < big_distance ||
+             big_distance - rest > rest + ten_kappa - big_distance))
+        return 0;
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+/* Grisu3's digit generation. Low and high are the scaled boundaries of the
+ * interval, which are widened by a unit to get the interval that certainly
+ * contains everything that reads back as the number. Returns the number of
+ * digits, or 0 if we can't be sure of them. */
+static MVMint32 grisu3_digit_gen(DiyFp W, DiyFp low, DiyFp high, char *buffer, MVMint32 *K) {
+    MVMuint64 unit            = 1;
+    MVMuint64 too_low         = low.f - unit;
+    MVMuint64 too_high        = high.f + unit;
+    MVMuint64 unsafe_interval = too_high - too_low;
+    MVMint32  shift           = -W.e;
+    MVMuint64 one             = 1ULL << shift;
+    MVMuint32 integrals       = (MVMuint32)(too_high >> shift);
+    MVMuint64 fractionals     = too_high & (one - 1);
+    MVMint32  kappa           = count_decimal_digits(integrals);
+    MVMint32  len             = 0;
+
+    while (kappa > 0) {
+        MVMuint32 divisor = (MVMuint32)pow10_u64[kappa - 1];
+        MVMuint32 d       = integrals / divisor;
+        MVMuint64 rest;
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        integrals %= divisor;
+        kappa--;
+        rest = ((MVMuint64)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            *K += kappa;
+            return grisu3_round_weed(buffer, len, too_high - W.f, unsafe_interval, rest,
+                (MVMuint64)divisor << shift, unit) ? len : 0;
+        }
+    }
+
+    while (1) {
+        char d;
+        fractionals     *= 10;
+        unit            *= 10;
+        unsafe_interval *= 10;
+        d                = (char)(fractionals >> shift);
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        fractionals     &= one - 1;
+        kappa--;
+        if (fractionals < unsafe_interval) {
+            *K += kappa;
+            return grisu3_round_weed(buffer, len, (too_high - W.f) * unit, unsafe_interval,
+                fractionals, one, unit) ? len : 0;
+        }
+    }
+}
+
+/* Tries to shorten Grisu2's digits, for the cases Grisu3 is unsure of, by
+ * rounding them down or up to fewer digits and seeing if those read back as
+ * the number. Rounding the digits to the nearest is tried first, so we get
+ * the closest of two candidates that both read back. */
+static MVMint32 shorten_digits(MVMnum64 n, char *buffer, MVMint32 len, MVMint32 *K) {
+    MVMint32 m;
+    for (m = 1; m < len; m++) {
+        MVMuint64 down = 0, candidates[2];
+        MVMint32  i, c;
+        for (i = 0; i < m; i++)
+            down = down * 10 + (MVMuint64)(buffer[i] - '0');
+        candidates[0] = buffer[m] >= '5' ? down + 1 : down;
+        candidates[1] = buffer[m] >= '5' ? down : down + 1;
+        for (c = 0; c < 2; c++) {
+            if (MVM_parse_decimal_to_double(candidates[c], *K + len - m, 0) == n) {
+                /* Rounding up may carry into an extra digit; that's a
+                 * trailing zero, which the caller drops. */
+                MVMuint64 value  = candidates[c];
+                MVMint32  digits = value >= pow10_u64[m] ? m + 1 : m;
+                *K += len - m;
+                for (i = digits - 1; i >= 0; i--) {
+                    buffer[i] = (char)('0' + value % 10);
+                    value    /= 10;
+                }
+                return digits;
+            }
+        }
+    }
+    return len;
+}
+
+/* Writes the digits for a positive, finite number into buffer (which needs
+ * space for 17), returning how many there are; the number is those digits
+ * times 10 to the power put into K. */
+MVMint32 MVM_num_shortest_digits(MVMnum64 n, char *buffer, MVMint32 *K) {
+    MVMuint64 bits;
+    MVMint32  biased_e, len, cached_K;
+    DiyFp     v, w_plus, w_minus, c_mk, W, Wp, Wm;
+
+    memcpy(&bits, &n, sizeof(bits));
+    biased_e = (MVMint32)((bits & DP_EXPONENT_MASK) >> 52);
+    v.f      = bits & DP_SIGNIFICAND_MASK;
+    if (biased_e) {
+        v.f += DP_HIDDEN_BIT;
+        v.e  = biased_e - 1075;
+    }
+    else {
+        v.e  = -1074;
+    }
+
+    /* The boundaries halfway to the neighbouring numbers, with the upper one
+     * normalized and the lower one given the same exponent. */
+    w_plus.f = (v.f << 1) + 1;
+    w_plus.e = v.e - 1;
+    while (!(w_plus.f & (DP_HIDDEN_BIT << 1))) {
+        w_plus.f <<= 1;
+        w_plus.e--;
+    }
+    w_plus.f <<= 10;
+    w_plus.e  -= 10;
+    if (v.f == DP_HIDDEN_BIT) {
+        w_minus.f = (v.f << 2) - 1;
+        w_minus.e = v.e - 2;
+    }
+    else {
+        w_minus.f = (v.f << 1) - 1;
+        w_minus.e = v.e - 1;
+    }
+    w_minus.f <<= w_minus.e - w_plus.e;
+    w_minus.e   = w_plus.e;
+
+    c_mk = cached_power(w_plus.e, &cached_K);
+    W    = diyfp_multiply(diyfp_normalize(v), c_mk);
+    Wp   = diyfp_multiply(w_plus, c_mk);
+    Wm   = diyfp_multiply(w_minus, c_mk);
+    *K   = cached_K;
+    len  = grisu3_digit_gen(W, Wm, Wp, buffer, K);
+    if (len)
+        return len;
+
+    /* Grisu3 was unsure; use Grisu2's conservative interval instead. */
+    Wm.f++;
+    Wp.f--;
+    *K  = cached_K;
+    len = digit_gen(W, Wp, Wp.f - Wm.f, buffer, K);
+    return shorten_digits(n, buffer, len, K);
+}
@@ -2,3 +2,4 @@ MVMint64 MVM_num_isnanorinf(MVMThreadContext *tc, MVMnum64 n);
 MVMnum64 MVM_num_posinf(MVMThreadContext *tc);
 MVMnum64 MVM_num_neginf(MVMThreadContext *tc);
 MVMnum64 MVM_num_nan(MVMThreadContext *tc);
+MVMint32 MVM_num_shortest_digits(MVMnum64 n, char *buffer, MVMint32 *K);
@@ -75,6 +75,9 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up instance data structure. */
     instance = MVM_calloc(1, sizeof(MVMInstance));
 
+    /* Pick the key for hashing strings, before any get hashed. */
+    MVM_string_hash_key_init(instance);
+
     /* Create the main thread's ThreadContext and stash it. */
     instance->main_thread = MVM_tc_create(NULL, instance);
 
@@ -265,6 +268,15 @@ MVMInstance * MVM_vm_create_instance(void) {
         instance->coverage_logging = 0;
     }
 
+#if MVM_OP_PROFILE
+    if (getenv("MVM_OP_PROFILE_LOG")) {
+        char *op_profile_log = getenv("MVM_OP_PROFILE_LOG");
+        MVM_op_profile_setup(instance, strlen(op_profile_log)
+            ? fopen_perhaps_with_pid(op_profile_log, "w")
+            : stderr, getenv("MVM_OP_PROFILE_PAIRS") ? 1 : 0);
+    }
+#endif
+
     /* Create std[in/out/err]. */
     setup_std_handles(instance->main_thread);
 
@@ -362,6 +374,8 @@ void MVM_vm_exit(MVMInstance *instance) {
         fprintf(instance->dynvar_log_fh, "- x 0 0 0 0 %"PRId64" %"PRIu64" %"PRIu64"\n", instance->dynvar_log_lasttime, uv_hrtime(), uv_hrtime());
         fclose(instance->dynvar_log_fh);
     }
+    if (instance->op_profile)
+        MVM_op_profile_write(instance);
 
     /* And, we're done. */
     exit(0);
@@ -468,6 +482,10 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
         fclose(instance->jit_log_fh);
     if (instance->dynvar_log_fh)
         fclose(instance->dynvar_log_fh);
+    if (instance->op_profile) {
+        MVM_op_profile_write(instance);
+        MVM_op_profile_destroy(instance);
+    }
 
     /* Clean up cross-thread-write-logging mutex */
     uv_mutex_destroy(&instance->mutex_cross_thread_write_logging);
@@ -107,6 +107,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/bytecode.h"
 #include "core/bytecodedump.h"
 #include "core/ops.h"
+#include "core/superops.h"
 #include "core/threads.h"
 #include "core/hll.h"
 #include "core/loadbytecode.h"
@@ -121,6 +122,8 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/nativecall.h"
 #include "core/dll.h"
 #include "core/continuation.h"
+#include "core/inlinecache.h"
+#include "core/str_hash_table.h"
 #include "6model/reprs.h"
 #include "6model/reprconv.h"
 #include "6model/bootstrap.h"
@@ -189,6 +192,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "profiler/profile.h"
 #include "profiler/heapsnapshot.h"
 #include "profiler/telemeh.h"
+#include "profiler/opprofile.h"
 #include "instrument/crossthreadwrite.h"
 #include "instrument/line_coverage.h"
 
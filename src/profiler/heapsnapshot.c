@@ -449,9 +449,14 @@ static void process_workitems(MVMThreadContext *tc, MVMHeapSnapshotState *ss) {
                     (MVMCollectable *)frame->code_ref, "Code reference");
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
                     (MVMCollectable *)frame->static_info, "Static frame");
-                MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                    (MVMCollectable *)frame->dynlex_cache_name,
-                    "Dynamic lexical cache name");
+                if (frame->dynlex_cache) {
+                    MVMuint32 j;
+                    for (j = 0; j < MVM_DYNLEX_CACHE_SIZE; j++)
+                        MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
+                            (MVMCollectable *)frame->dynlex_cache->entries[j].name,
+                            "Dynamic lexical cache name");
+                    col.unmanaged_size += sizeof(MVMDynlexCache);
+                }
 
                 if (frame->special_return_data && frame->mark_special_return_data) {
                     frame->mark_special_return_data(tc, frame, ss->gcwl);
@@ -0,0 +1,272 @@
+#include "moar.h"
+
+/* Works out how many bytes an op and its operands take up in the bytecode
+ * stream. */
+static MVMuint8 op_size(const MVMOpInfo *info) {
+    MVMuint8 size = 2;
+    MVMuint8 i;
+    for (i = 0; i < info->num_operands; i++) {
+        MVMuint8 flags = info->operands[i];
+        switch (flags & MVM_operand_rw_mask) {
+            case MVM_operand_read_reg:
+            case MVM_operand_write_reg:
+                size += 2;
+                break;
+            case MVM_operand_read_lex:
+            case MVM_operand_write_lex:
+                size += 4;
+                break;
+            default:
+                switch (flags & MVM_operand_type_mask) {
+                    case MVM_operand_int8:
+                    case MVM_operand_uint8:
+                        size += 1;
+                        break;
+                    case MVM_operand_int16:
+                    case MVM_operand_uint16:
+                    case MVM_operand_coderef:
+                    case MVM_operand_callsite:
+                    case MVM_operand_spesh_slot:
+                        size += 2;
+                        break;
+                    case MVM_operand_int32:
+                    case MVM_operand_uint32:
+                    case MVM_operand_num32:
+                    case MVM_operand_str:
+                    case MVM_operand_ins:
+                        size += 4;
+                        break;
+                    case MVM_operand_int64:
+                    case MVM_operand_uint64:
+                    case MVM_operand_num64:
+                        size += 8;
+                        break;
+                }
+        }
+    }
+    return size;
+}
+
+/* Sets up op profiling, which will be written to the specified file. We
+ * only count op pairs if asked to, since it needs a lot of memory. */
+void MVM_op_profile_setup(MVMInstance *instance, FILE *fh, MVMint32 pairs) {
+    MVMOpProfile *prof = MVM_calloc(1, sizeof(MVMOpProfile));
+    MVMuint16 i;
+    int init_stat;
+    while (MVM_op_get_op(prof->num_ops))
+        prof->num_ops++;
+    prof->op_sizes = MVM_malloc(prof->num_ops);
+    for (i = 0; i < prof->num_ops; i++)
+        prof->op_sizes[i] = op_size(MVM_op_get_op(i));
+    for (i = 0; i < 2; i++) {
+        prof->op_counts[i] = MVM_calloc(prof->num_ops + 1, sizeof(MVMuint64));
+        if (pairs)
+            prof->pair_counts[i] = MVM_calloc((size_t)prof->num_ops * prof->num_ops,
+                sizeof(MVMuint64));
+    }
+    if ((init_stat = uv_mutex_init(&prof->mutex_frames)) < 0) {
+        fprintf(stderr, "MoarVM: Initialization of op profile mutex failed\n    %s\n",
+            uv_strerror(init_stat));
+        exit(1);
+    }
+    prof->fh = fh;
+    instance->op_profile = prof;
+}
+
+/* Describes a static frame for the report. */
+static char * describe_frame(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMBytecodeAnnotation *annot = MVM_bytecode_resolve_annotation(tc, &sf->body, 0);
+    MVMString *filename = sf->body.cu->body.filename;
+    char      *name_c   = sf->body.name
+        ? MVM_string_utf8_encode_C_string(tc, sf->body.name)
+        : NULL;
+    char      *file_c   = filename
+        ? MVM_string_utf8_encode_C_string(tc, filename)
+        : NULL;
+    char      *result   = MVM_malloc(strlen(name_c ? name_c : "") + strlen(file_c ? file_c : "") + 64);
+    sprintf(result, "%s (%s:%u)",
+        name_c && *name_c ? name_c : "<anonymous frame>",
+        file_c ? file_c : "<ephemeral file>",
+        annot ? annot->line_number : 1);
+    MVM_free(name_c);
+    MVM_free(file_c);
+    MVM_free(annot);
+    return result;
+}
+
+/* Finds (or creates) the record for the frame we're now running. */
+static MVMOpProfileFrame * find_frame(MVMThreadContext *tc, MVMOpProfile *prof) {
+    MVMStaticFrame    *sf       = tc->cur_frame->static_info;
+    MVMuint8          *bytecode = sf->body.orig_bytecode;
+    MVMOpProfileFrame *frame;
+    uv_mutex_lock(&prof->mutex_frames);
+    HASH_FIND(hash_handle, prof->frames, &bytecode, sizeof(MVMuint8 *), frame);
+    if (!frame) {
+        frame           = MVM_calloc(1, sizeof(MVMOpProfileFrame));
+        frame->bytecode = bytecode;
+        frame->name     = describe_frame(tc, sf);
+        HASH_ADD_KEYPTR(hash_handle, prof->frames, &(frame->bytecode), sizeof(MVMuint8 *), frame);
+    }
+    uv_mutex_unlock(&prof->mutex_frames);
+    return frame;
+}
+
+/* Records the op about to be executed at cur_op. We only count a pair if the
+ * second op directly follows the first in the bytecode, so branches, calls
+ * and returns don't produce pairs that could never be fused. */
+void MVM_op_profile_record(MVMThreadContext *tc, MVMOpProfileCursor *cursor,
+        MVMuint8 *cur_op, MVMuint8 *bytecode_start) {
+    MVMOpProfile *prof = tc->instance->op_profile;
+    MVMuint16     op   = *((MVMuint16 *)cur_op);
+
+    /* If we're in different bytecode to last time, we've switched frames. */
+    if (bytecode_start != cursor->bytecode) {
+        cursor->bytecode = bytecode_start;
+        cursor->frame    = find_frame(tc, prof);
+        cursor->kind     = tc->cur_frame->spesh_cand
+            ? MVM_OP_PROFILE_SPESH
+            : MVM_OP_PROFILE_INTERP;
+    }
+    cursor->frame->counts[cursor->kind]++;
+
+    if (op >= prof->num_ops) {
+        prof->op_counts[cursor->kind][prof->num_ops]++;
+        cursor->prev_pos = NULL;
+        return;
+    }
+    prof->op_counts[cursor->kind][op]++;
+
+    if (prof->pair_counts[cursor->kind] && cursor->prev_pos
+            && cursor->prev_pos + prof->op_sizes[cursor->prev_op] == cur_op)
+        prof->pair_counts[cursor->kind][(size_t)cursor->prev_op * prof->num_ops + op]++;
+    cursor->prev_pos = cur_op;
+    cursor->prev_op  = op;
+}
+
+/* Things we sort for the report, most frequent first. */
+typedef struct {
+    MVMuint16          first;
+    MVMuint16          second;
+    MVMOpProfileFrame *frame;
+    MVMuint64          count;
+} ReportItem;
+static int compare_report_items(const void *a, const void *b) {
+    MVMuint64 count_a = ((const ReportItem *)a)->count;
+    MVMuint64 count_b = ((const ReportItem *)b)->count;
+    return count_a < count_b ? 1 : count_a > count_b ? -1 : 0;
+}
+
+static const char * kind_name(MVMuint32 kind) {
+    return kind == MVM_OP_PROFILE_SPESH ? "spesh" : "interp";
+}
+static const char * op_name(MVMOpProfile *prof, MVMuint16 op) {
+    return op < prof->num_ops ? MVM_op_get_op(op)->name : "<extop>";
+}
+
+/* Writes out the profile. Each line is a record type followed by its
+ * fields, separated by spaces, with the frame description last since it may
+ * contain spaces itself. */
+void MVM_op_profile_write(MVMInstance *instance) {
+    MVMThreadContext  *tc   = instance->main_thread;
+    MVMOpProfile      *prof = instance->op_profile;
+    MVMOpProfileFrame *frame, *tmp;
+    unsigned           bucket_tmp;
+    ReportItem        *items;
+    size_t             num_items, alloc_items, num_pairs, i, j;
+    MVMuint32          kind;
+
+    if (!prof || !prof->fh)
+        return;
+    num_pairs   = (size_t)prof->num_ops * prof->num_ops;
+    alloc_items = prof->num_ops + 1;
+    items       = MVM_malloc(alloc_items * sizeof(ReportItem));
+
+    /* Ops. */
+    fprintf(prof->fh, "# op <interp|spesh> <op> <count>\n");
+    for (kind = 0; kind < 2; kind++) {
+        num_items = 0;
+        for (i = 0; i <= prof->num_ops; i++) {
+            if (prof->op_counts[kind][i]) {
+                items[num_items].first = i;
+                items[num_items].count = prof->op_counts[kind][i];
+                num_items++;
+            }
+        }
+        qsort(items, num_items, sizeof(ReportItem), compare_report_items);
+        for (i = 0; i < num_items; i++)
+            fprintf(prof->fh, "op %s %s %"PRIu64"\n", kind_name(kind),
+                op_name(prof, items[i].first), items[i].count);
+    }
+
+    /* Frames. */
+    num_items = 0;
+    HASH_ITER(hash_handle, prof->frames, frame, tmp, bucket_tmp) {
+        if (num_items == alloc_items) {
+            alloc_items *= 2;
+            items = MVM_realloc(items, alloc_items * sizeof(ReportItem));
+        }
+        items[num_items].frame = frame;
+        items[num_items].count = frame->counts[0] + frame->counts[1];
+        num_items++;
+    }
+    qsort(items, num_items, sizeof(ReportItem), compare_report_items);
+    fprintf(prof->fh, "# frame <total> <interp> <spesh> <frame>\n");
+    for (i = 0; i < num_items; i++)
+        fprintf(prof->fh, "frame %"PRIu64" %"PRIu64" %"PRIu64" %s\n", items[i].count,
+            items[i].frame->counts[MVM_OP_PROFILE_INTERP],
+            items[i].frame->counts[MVM_OP_PROFILE_SPESH],
+            items[i].frame->name);
+
+    /* Pairs. */
+    if (prof->pair_counts[0]) {
+        fprintf(prof->fh, "# pair <interp|spesh> <first op> <second op> <count>\n");
+        for (kind = 0; kind < 2; kind++) {
+            num_items = 0;
+            for (i = 0; i < num_pairs; i++) {
+                if (!prof->pair_counts[kind][i])
+                    continue;
+                if (num_items == alloc_items) {
+                    alloc_items *= 2;
+                    items = MVM_realloc(items, alloc_items * sizeof(ReportItem));
+                }
+                items[num_items].first  = i / prof->num_ops;
+                items[num_items].second = i % prof->num_ops;
+                items[num_items].count  = prof->pair_counts[kind][i];
+                num_items++;
+            }
+            qsort(items, num_items, sizeof(ReportItem), compare_report_items);
+            for (j = 0; j < num_items; j++)
+                fprintf(prof->fh, "pair %s %s %s %"PRIu64"\n", kind_name(kind),
+                    op_name(prof, items[j].first), op_name(prof, items[j].second),
+                    items[j].count);
+        }
+    }
+    MVM_free(items);
+
+    if (prof->fh != stderr)
+        fclose(prof->fh);
+    prof->fh = NULL;
+}
+
+/* Frees the memory associated with op profiling. */
+void MVM_op_profile_destroy(MVMInstance *instance) {
+    MVMThreadContext  *tc   = instance->main_thread;
+    MVMOpProfile      *prof = instance->op_profile;
+    MVMOpProfileFrame *frame, *tmp;
+    unsigned           bucket_tmp;
+    if (prof) {
+        HASH_ITER(hash_handle, prof->frames, frame, tmp, bucket_tmp) {
+            HASH_DELETE(hash_handle, prof->frames, frame);
+            MVM_free(frame->name);
+            MVM_free(frame);
+        }
+        uv_mutex_destroy(&prof->mutex_frames);
+        MVM_free(prof->op_sizes);
+        MVM_free(prof->op_counts[0]);
+        MVM_free(prof->op_counts[1]);
+        MVM_free(prof->pair_counts[0]);
+        MVM_free(prof->pair_counts[1]);
+        MVM_free(prof);
+        instance->op_profile = NULL;
+    }
+}
@@ -0,0 +1,72 @@
+/* Op profiling. When MoarVM is built with MVM_OP_PROFILE (make opprofile)
+ * and MVM_OP_PROFILE_LOG is set, the interpreter counts how often each op
+ * is executed, and how many ops each static frame executes, keeping counts
+ * for unspecialized and specialized code apart. If MVM_OP_PROFILE_PAIRS is
+ * also set, it counts how often each pair of adjacent ops is executed too;
+ * tools/gen_superops.pl uses these to pick superinstructions. A report is
+ * written at exit, with the most frequent first in each section. */
+
+/* Which kind of code ops were executed in. */
+#define MVM_OP_PROFILE_INTERP   0
+#define MVM_OP_PROFILE_SPESH    1
+
+struct MVMOpProfile {
+    /* The number of (core) ops we know about. Extension ops are all counted
+     * in the slot after the last core op. */
+    MVMuint16 num_ops;
+
+    /* The number of bytes each op and its operands take. */
+    MVMuint8 *op_sizes;
+
+    /* Counts of ops executed, indexed by kind of code and then op. These
+     * may be hit up by multiple threads and lose the odd count, which is
+     * fine for the purpose. */
+    MVMuint64 *op_counts[2];
+
+    /* Counts of op pairs, indexed by kind of code and then by first op *
+     * num_ops + second op; NULL if we're not counting pairs. */
+    MVMuint64 *pair_counts[2];
+
+    /* Counts per static frame, hashed on the frame's original bytecode, and
+     * a mutex protecting the hash. */
+    MVMOpProfileFrame *frames;
+    uv_mutex_t mutex_frames;
+
+    /* The file to write the profile to. */
+    FILE *fh;
+};
+
+/* Ops executed by a static frame. */
+struct MVMOpProfileFrame {
+    /* The original bytecode of the static frame, which we hash on. */
+    MVMuint8 *bytecode;
+
+    /* Description of the frame, for the report. */
+    char *name;
+
+    /* Count of ops executed, indexed by kind of code. */
+    MVMuint64 counts[2];
+
+    /* Hash handle. */
+    UT_hash_handle hash_handle;
+};
+
+/* Per-interpreter state used while recording, so we know what ran last and
+ * what we're running. */
+struct MVMOpProfileCursor {
+    /* The position and number of the last op we recorded, if any. */
+    MVMuint8  *prev_pos;
+    MVMuint16  prev_op;
+
+    /* The bytecode we're running, the frame record we're counting it in,
+     * and which kind of code it is. */
+    MVMuint8          *bytecode;
+    MVMOpProfileFrame *frame;
+    MVMuint8           kind;
+};
+
+void MVM_op_profile_setup(MVMInstance *instance, FILE *fh, MVMint32 pairs);
+void MVM_op_profile_record(MVMThreadContext *tc, MVMOpProfileCursor *cursor,
+    MVMuint8 *cur_op, MVMuint8 *bytecode_start);
+void MVM_op_profile_write(MVMInstance *instance);
+void MVM_op_profile_destroy(MVMInstance *instance);
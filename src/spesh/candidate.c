@@ -226,9 +226,10 @@ void MVM_spesh_candidate_specialize(MVMThreadContext *tc, MVMStaticFrame *static
     MVM_free(candidate->log_slots);
     candidate->log_slots = NULL;
 
-    /* Update spesh slots. */
+    /* Update spesh slots, and set up inline caches to go with them. */
     candidate->num_spesh_slots = sg->num_spesh_slots;
     candidate->spesh_slots     = sg->spesh_slots;
+    MVM_inline_cache_setup_spesh(tc, &candidate->inline_cache, sg->num_spesh_slots);
 
     /* May now be referencing nursery objects, so barrier just in case. */
     if (static_frame->common.header.flags & MVM_CF_SECOND_GEN)
@@ -269,6 +270,7 @@ void MVM_spesh_candidate_destroy(MVMThreadContext *tc, MVMSpeshCandidate *candid
     MVM_free(candidate->inlines);
     MVM_free(candidate->local_types);
     MVM_free(candidate->lexical_types);
+    MVM_inline_cache_destroy(tc, &candidate->inline_cache);
     if (candidate->jitcode)
         MVM_jit_destroy_code(tc, candidate->jitcode);
 }
@@ -84,6 +84,9 @@ struct MVMSpeshCandidate {
 
     /* JIT-code structure */
     MVMJitCode *jitcode;
+
+    /* Inline caches for method lookups, indexed by spesh slot. */
+    MVMInlineCache inline_cache;
 };
 
 /* The number of specializations we'll allow per static frame. */
@@ -61,6 +61,22 @@ static void write_num64(SpeshWriterState *ws, MVMnum64 value) {
     ws->bytecode_pos += 8;
 }
 
+/* Gets the opcode to write for a core op. If it and the instruction after it
+ * have a superinstruction (see tools/gen_superops.pl), we write that; the
+ * following instruction is still written as normal, so nothing else about
+ * the bytecode changes. We don't fuse when building for op profiling, so
+ * that the profile shows the pairs as they really are. */
+static MVMuint16 core_opcode(MVMThreadContext *tc, MVMSpeshIns *ins) {
+#if !MVM_OP_PROFILE
+    if (ins->next) {
+        MVMuint16 fused = MVM_superop_for(ins->info->opcode, ins->next->info->opcode);
+        if (fused)
+            return fused;
+    }
+#endif
+    return ins->info->opcode;
+}
+
 /* Writes instructions within a basic block boundary. */
 static void write_instructions(MVMThreadContext *tc, MVMSpeshGraph *g, SpeshWriterState *ws, MVMSpeshBB *bb) {
     MVMSpeshIns *ins = bb->first_ins;
@@ -127,7 +143,7 @@ static void write_instructions(MVMThreadContext *tc, MVMSpeshGraph *g, SpeshWrit
             }
             else {
                 /* Core op. */
-                write_int16(ws, ins->info->opcode);
+                write_int16(ws, core_opcode(tc, ins));
             }
 
             /* Write out operands. */
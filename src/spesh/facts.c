@@ -124,6 +124,10 @@ MVMint32 MVM_spesh_facts_decont_blocked_by_alias(MVMThreadContext *tc, MVMSpeshG
             case MVM_OP_assign_s:
             case MVM_OP_sp_bind_o:
             case MVM_OP_sp_p6obind_o:
+            case MVM_OP_casattr_o:
+            case MVM_OP_atomicbindattr_o:
+            case MVM_OP_sp_p6ocas_o:
+            case MVM_OP_sp_p6oatomicbind_o:
                 return 1;
         }
     }
@@ -21,10 +21,12 @@ void * MVM_spesh_alloc(MVMThreadContext *tc, MVMSpeshGraph *g, size_t bytes) {
 }
 
 /* Looks up op info; doesn't sanity check, since we should be working on code
- * that already pass validation. */
+ * that already pass validation. Specialized code (which we re-read when we
+ * inline it) may contain superinstructions, which we map back to the first
+ * op they fuse; the second is still in the bytecode after it. */
 static const MVMOpInfo * get_op_info(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint16 opcode) {
     if (opcode < MVM_OP_EXT_BASE) {
-        return MVM_op_get_op(opcode);
+        return MVM_op_get_op(MVM_superop_unfuse(opcode));
     }
     else {
         MVMuint16       index  = opcode - MVM_OP_EXT_BASE;
@@ -127,16 +127,16 @@ static void optimize_method_lookup(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSp
         }
     }
 
-    /* If not, add space to cache a single type/method pair, to save hash
-     * lookups in the (common) monomorphic case, and rewrite to caching
-     * version of the instruction. */
+    /* If not, rewrite to the caching version of the instruction. It gets
+     * an (empty) spesh slot, whose index identifies its inline cache slot;
+     * that caches a few type/method pairs, saving hash lookups in the
+     * (common) monomorphic and polymorphic cases. */
     if (!resolved) {
         MVMSpeshOperand *orig_o = ins->operands;
         ins->info = MVM_op_get_op(MVM_OP_sp_findmeth);
         ins->operands = MVM_spesh_alloc(tc, g, 4 * sizeof(MVMSpeshOperand));
         memcpy(ins->operands, orig_o, 3 * sizeof(MVMSpeshOperand));
         ins->operands[3].lit_i16 = MVM_spesh_add_spesh_slot(tc, g, NULL);
-        MVM_spesh_add_spesh_slot(tc, g, NULL);
     }
 }
 
@@ -184,7 +184,8 @@ static void optimize_is_reprid(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshI
 
     MVM_spesh_use_facts(tc, g, obj_facts);
 
-    result_value = REPR(obj_facts->type)->ID == wanted_repr_id;
+    result_value = REPR(obj_facts->type)->ID == wanted_repr_id
+        || (wanted_repr_id == MVM_REPR_ID_MVMHash && REPR(obj_facts->type)->ID == MVM_REPR_ID_ConcHash);
 
     if (result_value == 0) {
         MVMSpeshFacts *result_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
@@ -1275,6 +1276,94 @@ static void optimize_uniprop_ops(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpes
 }
 }
 
+/* Atomic integer ops on a reference just taken to a native attribute of an
+ * object of known type can be done directly on the attribute, without the
+ * reference object being needed. */
+static void optimize_atomic_op(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+#if MVM_PTR_SIZE >= 8
+    MVMuint16        opcode    = ins->info->opcode;
+    MVMuint16        ref_idx   = opcode == MVM_OP_atomicstore_i ? 0 : 1;
+    MVMSpeshFacts   *ref_facts = MVM_spesh_get_facts(tc, g, ins->operands[ref_idx]);
+    MVMSpeshIns     *ref_ins   = ref_facts->writer;
+    MVMSpeshFacts   *obj_facts;
+    MVMSpeshFacts   *ch_facts;
+    MVMSpeshIns     *cur;
+    MVMSpeshOperand *orig_operands;
+    MVMint64         offset;
+
+    if (!ref_ins || ref_ins->info->opcode != MVM_OP_getattrref_i)
+        return;
+    obj_facts = MVM_spesh_get_facts(tc, g, ref_ins->operands[1]);
+    ch_facts  = MVM_spesh_get_facts(tc, g, ref_ins->operands[2]);
+    if (!(obj_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) || !(obj_facts->flags & MVM_SPESH_FACT_CONCRETE)
+            || !obj_facts->type || !(ch_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) || !ch_facts->type)
+        return;
+    offset = MVM_p6opaque_int64_attr_offset(tc, obj_facts->type, ch_facts->type,
+        MVM_spesh_get_string(tc, g, ref_ins->operands[3]));
+    if (offset < 0)
+        return;
+
+    /* The object register will be read at the atomic op rather than at the
+     * reference op, so make sure nothing in between writes to it. */
+    cur = ins->prev;
+    while (cur != ref_ins) {
+        if (!cur || cur->info->opcode == MVM_SSA_PHI)
+            return;
+        if (cur->info->num_operands
+                && (cur->info->operands[0] & MVM_operand_rw_mask) == MVM_operand_write_reg
+                && cur->operands[0].reg.orig == ref_ins->operands[1].reg.orig)
+            return;
+        cur = cur->prev;
+    }
+
+    orig_operands = ins->operands;
+    switch (opcode) {
+        case MVM_OP_cas_i:
+            ins->info        = MVM_op_get_op(MVM_OP_sp_p6ocas_i);
+            ins->operands    = MVM_spesh_alloc(tc, g, 5 * sizeof(MVMSpeshOperand));
+            ins->operands[0] = orig_operands[0];
+            ins->operands[3] = orig_operands[2];
+            ins->operands[4] = orig_operands[3];
+            break;
+        case MVM_OP_atomicinc_i:
+        case MVM_OP_atomicdec_i:
+        case MVM_OP_atomicload_i:
+            ins->info        = MVM_op_get_op(opcode == MVM_OP_atomicinc_i ? MVM_OP_sp_p6oatomicinc_i :
+                                             opcode == MVM_OP_atomicdec_i ? MVM_OP_sp_p6oatomicdec_i :
+                                                                            MVM_OP_sp_p6oatomicload_i);
+            ins->operands    = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+            ins->operands[0] = orig_operands[0];
+            break;
+        case MVM_OP_atomicadd_i:
+            ins->info        = MVM_op_get_op(MVM_OP_sp_p6oatomicadd_i);
+            ins->operands    = MVM_spesh_alloc(tc, g, 4 * sizeof(MVMSpeshOperand));
+            ins->operands[0] = orig_operands[0];
+            ins->operands[3] = orig_operands[2];
+            break;
+        case MVM_OP_atomicstore_i:
+            ins->info        = MVM_op_get_op(MVM_OP_sp_p6oatomicstore_i);
+            ins->operands    = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+            ins->operands[0] = ref_ins->operands[1];
+            ins->operands[1].lit_i16 = (MVMint16)offset;
+            ins->operands[2] = orig_operands[1];
+            break;
+        default:
+            return;
+    }
+    if (opcode != MVM_OP_atomicstore_i) {
+        ins->operands[1] = ref_ins->operands[1];
+        ins->operands[2].lit_i16 = (MVMint16)offset;
+    }
+
+    /* The reference is no longer used here; if it's not used elsewhere then
+     * the (pure) getattrref_i will be deleted as dead. */
+    ref_facts->usages--;
+    obj_facts->usages++;
+    MVM_spesh_use_facts(tc, g, obj_facts);
+    MVM_spesh_use_facts(tc, g, ch_facts);
+#endif
+}
+
 /* If something is only kept alive because we log its allocation, kick out
  * the allocation logging and let the op that creates it die.
  */
@@ -1613,6 +1702,7 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb)
         case MVM_OP_bindattrs_n:
         case MVM_OP_bindattrs_s:
         case MVM_OP_bindattrs_o:
+        case MVM_OP_atomicbindattr_o:
         case MVM_OP_assign_i:
         case MVM_OP_assign_n:
             optimize_repr_op(tc, g, bb, ins, 0);
@@ -1644,6 +1734,8 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb)
         case MVM_OP_getattrs_n:
         case MVM_OP_getattrs_s:
         case MVM_OP_getattrs_o:
+        case MVM_OP_casattr_o:
+        case MVM_OP_atomicloadattr_o:
         case MVM_OP_decont_i:
         case MVM_OP_decont_n:
         case MVM_OP_decont_s:
@@ -1682,6 +1774,14 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb)
         case MVM_OP_isrwcont:
             optimize_container_check(tc, g, bb, ins);
             break;
+        case MVM_OP_cas_i:
+        case MVM_OP_atomicinc_i:
+        case MVM_OP_atomicdec_i:
+        case MVM_OP_atomicadd_i:
+        case MVM_OP_atomicload_i:
+        case MVM_OP_atomicstore_i:
+            optimize_atomic_op(tc, g, bb, ins);
+            break;
         case MVM_OP_sp_log:
         case MVM_OP_sp_osrfinalize:
             /* Left-over log instruction that didn't become a guard, or OSR
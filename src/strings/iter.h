@@ -51,26 +51,49 @@ MVM_STATIC_INLINE void MVM_string_gi_init(MVMThreadContext *tc, MVMGraphemeIter
     }
 };
 
-/* Sets the position of the iterator. (Can be optimized in many ways in the
- * repetitions and strands branches.) */
+/* Finds the strand holding the given grapheme index, by binary search on
+ * the strand offsets. Returns the last strand starting at or before the
+ * index; the first strand must do so. */
+MVM_STATIC_INLINE MVMuint16 MVM_string_find_strand(MVMThreadContext *tc, MVMStringStrand *strands, MVMuint16 num_strands, MVMuint64 index) {
+    MVMuint16 lo = 0;
+    MVMuint16 hi = num_strands - 1;
+    while (lo < hi) {
+        MVMuint16 mid = lo + (hi - lo + 1) / 2;
+        if (strands[mid].offset <= index)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+/* Sets the position of the iterator, relative to where it is now. */
 MVM_STATIC_INLINE void MVM_string_gi_move_to(MVMThreadContext *tc, MVMGraphemeIter *gi, MVMuint32 pos) {
     MVMuint32 remaining = pos;
-    MVMuint32 strand_graphs;
+    MVMuint32 strand_graphs = (gi->end - gi->pos) + gi->repetitions * (gi->end - gi->start);
 
-    /* Find the appropriate strand. */
-    while (remaining > (strand_graphs = (gi->end - gi->pos) * (gi->repetitions + 1))) {
-        MVMStringStrand *next = gi->next_strand;
+    /* If it's past the current strand, binary search the ones remaining. */
+    if (remaining > strand_graphs) {
+        MVMStringStrand *current, *next;
+        MVMuint64 target;
+        MVMuint16 skip;
         if (!gi->strands_remaining)
             MVM_exception_throw_adhoc(tc, "Iteration past end of grapheme iterator");
+        current = gi->next_strand - 1;
+        target = (MVMuint64)current->offset
+            + (MVMuint64)(current->end - current->start) * (current->repetitions + 1)
+            - strand_graphs + remaining;
+        skip = MVM_string_find_strand(tc, gi->next_strand, gi->strands_remaining, target);
+        next = gi->next_strand + skip;
         gi->active_blob.any = next->blob_string->body.storage.any;
         gi->blob_type       = next->blob_string->body.storage_type;
         gi->pos             = next->start;
         gi->end             = next->end;
         gi->start           = next->start;
         gi->repetitions     = next->repetitions;
-        gi->strands_remaining--;
-        gi->next_strand++;
-        remaining -= strand_graphs;
+        gi->strands_remaining -= skip + 1;
+        gi->next_strand       += skip + 1;
+        remaining = (MVMuint32)(target - next->offset);
     }
 
     /* Now look within the strand. */
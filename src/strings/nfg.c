@@ -5,14 +5,22 @@
 #define MVM_SYNTHETIC_GROW_ELEMS 32
 
 /* Finds the index of a given codepoint within a trie node. Returns it if
- * there is one, or negative if there is not (note 0 is a valid index). */
+ * there is one, or negative if there is not (note 0 is a valid index). The
+ * entries are sorted by codepoint, so we binary search them. */
 static MVMint32 find_child_node_idx(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
     if (node) {
-        /* TODO: update this to do a binary search later on. */
-        MVMint32 i;
-        for (i = 0; i < node->num_entries; i++)
-            if (node->next_codes[i].code == cp)
-                return i;
+        MVMint32 lo = 0;
+        MVMint32 hi = node->num_entries;
+        while (lo < hi) {
+            MVMint32     mid  = lo + (hi - lo) / 2;
+            MVMCodepoint code = node->next_codes[mid].code;
+            if (code == cp)
+                return mid;
+            if (code < cp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
     }
     return -1;
 }
@@ -23,7 +31,7 @@ MVMNFGTrieNode * find_child_node(MVMThreadContext *tc, const MVMNFGTrieNode *nod
     return idx >= 0 ? node->next_codes[idx].node : NULL;
 }
 static MVMGrapheme32 lookup_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
-    MVMNFGTrieNode *cur_node        = tc->instance->nfg->grapheme_lookup;
+    MVMNFGTrieNode *cur_node        = (MVMNFGTrieNode *)MVM_load(&(tc->instance->nfg->grapheme_lookup));
     MVMCodepoint   *cur_code        = codes;
     MVMint32        codes_remaining = num_codes;
     while (cur_node && codes_remaining) {
@@ -34,6 +42,35 @@ static MVMGrapheme32 lookup_synthetic(MVMThreadContext *tc, MVMCodepoint *codes,
     return cur_node ? cur_node->graph : 0;
 }
 
+/* Picks the slot in the per-thread synthetics cache for some codepoints. */
+static MVMuint32 cache_slot(MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint32 hash = 0;
+    MVMint32  i;
+    for (i = 0; i < num_codes; i++)
+        hash = (hash ^ (MVMuint32)codes[i]) * 0x9E3779B1;
+    return hash >> (32 - MVM_NFG_CACHE_BITS);
+}
+
+/* Looks up a synthetic in the thread's cache of recently used ones before
+ * going to the trie. Entries are only hints; since synthetics are never
+ * removed, we check the one we find against the synthetics table, so an
+ * entry left over from some other codepoints just means a miss. */
+static MVMGrapheme32 lookup_synthetic_cached(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint32     slot   = cache_slot(codes, num_codes);
+    MVMGrapheme32 cached = tc->nfg_cache[slot];
+    MVMGrapheme32 result;
+    if (cached) {
+        MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, cached);
+        if (synth->base == codes[0] && synth->num_combs == num_codes - 1
+                && memcmp(synth->combs, codes + 1, synth->num_combs * sizeof(MVMCodepoint)) == 0)
+            return cached;
+    }
+    result = lookup_synthetic(tc, codes, num_codes);
+    if (result)
+        tc->nfg_cache[slot] = result;
+    return result;
+}
+
 /* Recursive algorithm to add to the trie. Descends existing trie nodes so far
  * as we have them following the code points, then passes on a NULL for the
  * levels of current below that do not exist. Once we bottom out, makes a copy
@@ -136,8 +173,7 @@ static MVMNFGTrieNode * twiddle_trie_node(MVMThreadContext *tc, MVMNFGTrieNode *
 static void add_synthetic_to_trie(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMGrapheme32 synthetic) {
     MVMNFGState    *nfg      = tc->instance->nfg;
     MVMNFGTrieNode *new_trie = twiddle_trie_node(tc, nfg->grapheme_lookup, codes, num_codes, synthetic);
-    MVM_barrier();
-    nfg->grapheme_lookup = new_trie;
+    MVM_store(&(nfg->grapheme_lookup), new_trie);
 }
 
 /* Assumes that we are holding the lock that serializes updates, and already
@@ -159,7 +195,7 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
             memcpy(new_synthetics, nfg->synthetics, orig_size);
             MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, orig_size, nfg->synthetics);
         }
-        nfg->synthetics = new_synthetics;
+        MVM_store(&(nfg->synthetics), new_synthetics);
     }
 
     /* Set up the new synthetic entry. */
@@ -194,13 +230,14 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
  * not, acquires the update lock, re-checks that we really are missing the
  * synthetic, and then adds it. */
 static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
-    MVMGrapheme32 result = lookup_synthetic(tc, codes, num_codes);
+    MVMGrapheme32 result = lookup_synthetic_cached(tc, codes, num_codes);
     if (!result) {
         uv_mutex_lock(&tc->instance->nfg->update_mutex);
         result = lookup_synthetic(tc, codes, num_codes);
         if (!result)
             result = add_synthetic(tc, codes, num_codes, utf8_c8);
         uv_mutex_unlock(&tc->instance->nfg->update_mutex);
+        tc->nfg_cache[cache_slot(codes, num_codes)] = result;
     }
     return result;
 }
@@ -356,19 +393,20 @@ MVM_STATIC_INLINE MVMint32 codepoint_GCB_Control (MVMThreadContext *tc, MVMCodep
 /* Returns non-zero if the result of concatenating the two strings will freely
  * leave us in NFG without any further effort. */
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b) {
-    MVMGrapheme32 last_a;
-    MVMGrapheme32 first_b;
-    MVMGrapheme32 crlf;
-
     /* If either string is empty, we're good. */
     if (a->body.num_graphs == 0 || b->body.num_graphs == 0)
         return 1;
 
-    /* Get first and last graphemes of the strings. */
-    last_a = MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1);
-    first_b = MVM_string_get_grapheme_at_nocheck(tc, b, 0);
+    /* Otherwise, it's down to the first and last graphemes of the strings. */
+    return MVM_nfg_is_concat_stable_graphemes(tc,
+        MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1),
+        MVM_string_get_grapheme_at_nocheck(tc, b, 0));
+}
 
-    crlf = MVM_nfg_crlf_grapheme(tc);
+/* Returns non-zero if putting the second grapheme straight after the first
+ * will leave us in NFG without any further effort. */
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b) {
+    MVMGrapheme32 crlf = MVM_nfg_crlf_grapheme(tc);
 
     /* If either is synthetic other than "\r\n", assume we'll have to re-normalize
      * (this is an over-estimate, most likely). Note if you optimize this that it
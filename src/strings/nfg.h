@@ -1,7 +1,8 @@
 /* State kept around for implementing Normal Form Grapheme. The design is such
  * that we can always do lookups without needing to acquire a lock. When we
  * do additions of new synthetics, we must acquire the lock before doing so,
- * and be sure to validate nothing changed. We also must do sufficient copying
+ * and be sure to validate nothing changed. New versions of the trie and the
+ * synthetics table are published with an atomic store. We also must do sufficient copying
  * to ensure that we never break another thread doing a read. Memory to be
  * freed is thus done at a global safe point, which means we never have one
  * thread reading memory freed by another. */
@@ -79,6 +80,11 @@ struct MVMNFGTrieNodeEntry {
  * in to. */
 #define MVM_GRAPHEME_MAX_CODEPOINTS 1024
 
+/* Number of bits of codepoint hash used to pick a slot in the per-thread
+ * cache of recently used synthetics, and so the number of slots. */
+#define MVM_NFG_CACHE_BITS 6
+#define MVM_NFG_CACHE_SIZE (1 << MVM_NFG_CACHE_BITS)
+
 /* Functions related to grapheme handling. */
 MVMGrapheme32 MVM_nfg_codes_to_grapheme(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes);
 MVMGrapheme32 MVM_nfg_codes_to_grapheme_utf8_c8(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes);
@@ -86,6 +92,7 @@ MVMGrapheme32 MVM_nfg_crlf_grapheme(MVMThreadContext *tc);
 MVMNFGSynthetic * MVM_nfg_get_synthetic_info(MVMThreadContext *tc, MVMGrapheme32 synth);
 MVMuint32 MVM_nfg_get_case_change(MVMThreadContext *tc, MVMGrapheme32 codepoint, MVMint32 case_, MVMGrapheme32 **result);
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b);
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b);
 
 /* NFG subsystem initialization and cleanup. */
 void MVM_nfg_init(MVMThreadContext *tc);
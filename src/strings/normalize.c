@@ -60,6 +60,16 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
     result_pos = 0;
     while (input_pos < input_codes) {
         MVMCodepoint cp;
+        MVMint32     consumed;
+
+        /* Runs of codepoints needing no work go straight to the result. */
+        maybe_grow_result(&result, &result_alloc, result_pos + input_codes - input_pos);
+        result_pos += MVM_unicode_normalizer_process_quick_run(tc, &norm,
+            input + input_pos, input_codes - input_pos, result + result_pos, &consumed);
+        input_pos += consumed;
+        if (input_pos == input_codes)
+            break;
+
         ready = MVM_unicode_normalizer_process_codepoint(tc, &norm, input[input_pos], &cp);
         if (ready) {
             maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -101,6 +111,16 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
     result_pos = 0;
     while (input_pos < cp_count) {
         MVMGrapheme32 g;
+        MVMint32      consumed;
+
+        /* Runs of codepoints needing no work are already graphemes. */
+        maybe_grow_result(&result, &result_alloc, result_pos + cp_count - input_pos);
+        result_pos += MVM_unicode_normalizer_process_quick_run(tc, &norm,
+            cp_v + input_pos, cp_count - input_pos, result + result_pos, &consumed);
+        input_pos += consumed;
+        if (input_pos == cp_count)
+            break;
+
         ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, cp_v[input_pos], &g);
         if (ready) {
             maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -729,6 +749,67 @@ MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVM
     return norm->buffer_norm_end - norm->buffer_start++;
 }
 
+/* Checks if a codepoint is one that, if followed by another such codepoint,
+ * the normalizer will hand straight back without any further work and without
+ * changing any of its state: it passes the quick check, is a starter, and is
+ * neither a control nor anything grapheme clustering treats specially. */
+static MVMint32 passes_quick_run(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    if (cp < 0x20 || (cp >= 0x7F && cp <= 0x9F) || cp == 0xAD)
+        return 0;
+    if (cp < n->first_significant)
+        return 1;
+    return passes_quickcheck(tc, n, cp) && ccc(tc, cp) == 0
+        && !is_grapheme_prepend(tc, cp) && !is_grapheme_extend(tc, cp)
+        && !(cp > 0xFF && is_control_beyond_latin1(tc, cp));
+}
+
+/* Processes as many codepoints from the start of the input as form a run that
+ * needs no normalization work, writing those that are ready to out, which
+ * must have space for num_in codepoints. Returns the number written, and sets
+ * consumed to the number of input codepoints processed, which may be 0; the
+ * rest should go through process_codepoint as usual. The result and the state
+ * of the normalizer afterwards are just as if the consumed codepoints had been
+ * passed to process_codepoint one at a time. */
+MVMint32 MVM_unicode_normalizer_process_quick_run(MVMThreadContext *tc, MVMNormalizer *n,
+        const MVMCodepoint *in, MVMint32 num_in, MVMCodepoint *out, MVMint32 *consumed) {
+    MVMint32 buffered = n->buffer_end - n->buffer_start;
+    MVMint32 written  = 0;
+    MVMint32 run      = 0;
+
+    /* We can only go ahead if there's nothing pending, or when composing if
+     * the one codepoint pending could be handed back. */
+    *consumed = 0;
+    if (n->prepend_buffer || buffered > 1)
+        return 0;
+    if (buffered == 1 && (!MVM_NORMALIZE_COMPOSE(n->form)
+            || !passes_quick_run(tc, n, n->buffer[n->buffer_start])))
+        return 0;
+
+    while (run < num_in && passes_quick_run(tc, n, in[run]))
+        run++;
+    if (run == 0)
+        return 0;
+    *consumed = run;
+
+    /* When decomposing, all of them are ready right away. */
+    if (!MVM_NORMALIZE_COMPOSE(n->form)) {
+        memcpy(out, in, run * sizeof(MVMCodepoint));
+        return run;
+    }
+
+    /* When composing, the last one might yet combine with whatever follows,
+     * so it takes the place of anything pending in the buffer. */
+    if (buffered)
+        out[written++] = n->buffer[n->buffer_start];
+    memcpy(out + written, in, (run - 1) * sizeof(MVMCodepoint));
+    written += run - 1;
+    if (buffered)
+        n->buffer[n->buffer_start] = in[run - 1];
+    else
+        add_codepoint_to_buffer(tc, n, in[run - 1]);
+    return written;
+}
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints) {
     MVMint32 i;
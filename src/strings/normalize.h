@@ -124,6 +124,10 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint_to_grapheme(
     return MVM_unicode_normalizer_process_codepoint(tc, n, in, (MVMGrapheme32 *)out);
 }
 
+/* Bulk processing of a run of codepoints that need no normalization work. */
+MVMint32 MVM_unicode_normalizer_process_quick_run(MVMThreadContext *tc, MVMNormalizer *n,
+    const MVMCodepoint *in, MVMint32 num_in, MVMCodepoint *out, MVMint32 *consumed);
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints);
 
@@ -1,5 +1,6 @@
 #include "platform/memmem.h"
 #include "moar.h"
+#include "platform/time.h"
 #define MVM_DEBUG_STRANDS 0
 
 #if MVM_DEBUG_STRANDS
@@ -16,6 +17,18 @@ static void check_strand_sanity(MVMThreadContext *tc, MVMString *s) {
         MVM_exception_throw_adhoc(tc,
             "Strand sanity check failed (stand length %d != num_graphs %d)",
             len, MVM_string_graphs(tc, s));
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMStringStrand *strands = s->body.storage.strands;
+        MVMuint16        i;
+        len = 0;
+        for (i = 0; i < s->body.num_strands; i++) {
+            if (strands[i].offset != len)
+                MVM_exception_throw_adhoc(tc,
+                    "Strand sanity check failed (strand %d offset %d != %d)",
+                    i, strands[i].offset, len);
+            len += (strands[i].end - strands[i].start) * (strands[i].repetitions + 1);
+        }
+    }
 }
 #define STRAND_CHECK(tc, s) check_strand_sanity(tc, s);
 #else
@@ -92,12 +105,119 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     return result;
 }
 
+/* The number of graphemes a strand contributes, counting repetitions. */
+MVM_STATIC_INLINE MVMuint64 strand_graphs(MVMStringStrand *ss) {
+    return (MVMuint64)(ss->end - ss->start) * ((MVMuint64)ss->repetitions + 1);
+}
+
+/* Collapses the strands from up to (but not including) to of a strand
+ * string into a single blob string. */
+static MVMString * collapse_strand_run(MVMThreadContext *tc, MVMString *orig,
+        MVMuint16 from, MVMuint16 to) {
+    MVMString     *result;
+    MVMGrapheme32 *buffer;
+    MVMuint32      graphs = 0;
+    MVMuint32      pos    = 0;
+    MVMint32       fits_8bit = 1;
+    MVMuint16      i;
+
+    for (i = from; i < to; i++)
+        graphs += (MVMuint32)strand_graphs(&(orig->body.storage.strands[i]));
+    buffer = MVM_malloc(graphs * sizeof(MVMGrapheme32));
+
+    /* Copy the graphemes out before we allocate, since that may move the
+     * blob strings around. */
+    for (i = from; i < to; i++) {
+        MVMStringStrand *ss   = &(orig->body.storage.strands[i]);
+        MVMString       *blob = ss->blob_string;
+        MVMuint32        rep;
+        for (rep = 0; rep <= ss->repetitions; rep++) {
+            MVMStringIndex j;
+            if (blob->body.storage_type == MVM_STRING_GRAPHEME_32) {
+                for (j = ss->start; j < ss->end; j++) {
+                    MVMGrapheme32 g = blob->body.storage.blob_32[j];
+                    if (!can_fit_into_8bit(g))
+                        fits_8bit = 0;
+                    buffer[pos++] = g;
+                }
+            }
+            else {
+                for (j = ss->start; j < ss->end; j++)
+                    buffer[pos++] = blob->body.storage.blob_8[j];
+            }
+        }
+    }
+
+    MVMROOT(tc, orig, {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    result->body.num_graphs      = graphs;
+    result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+    result->body.storage.blob_32 = buffer;
+    if (fits_8bit)
+        turn_32bit_into_8bit_unchecked(tc, result);
+    return result;
+}
+
+/* When a concatenation leaves a strand string with more than the maximum
+ * number of strands, we collapse a run of strands at one end or the other
+ * into a blob string. Rather than collapsing everything, we take strands
+ * from the end until the next one is at least twice as big as what we have
+ * taken so far. That way the strands end up falling off in size towards the
+ * end we append to (or rising from the end we prepend to), with only about
+ * log2 of the string's length of them once collapsed, much like the digits
+ * of a binary counter; a grapheme gets copied O(log n) times over a run of
+ * appends, rather than on every collapse. We pick the end that means copying
+ * fewer graphemes. */
+static void collapse_strand_end(MVMThreadContext *tc, MVMString *s) {
+    MVMStringStrand *strands = s->body.storage.strands;
+    MVMuint16        num     = s->body.num_strands;
+    MVMuint64        tail_graphs, head_graphs;
+    MVMuint16        tail_from, head_to;
+    MVMString       *blob;
+
+    tail_from   = num - 2;
+    tail_graphs = strand_graphs(&strands[num - 1]) + strand_graphs(&strands[num - 2]);
+    while (tail_from > 0 && strand_graphs(&strands[tail_from - 1]) < 2 * tail_graphs) {
+        tail_from--;
+        tail_graphs += strand_graphs(&strands[tail_from]);
+    }
+    head_to     = 2;
+    head_graphs = strand_graphs(&strands[0]) + strand_graphs(&strands[1]);
+    while (head_to < num && strand_graphs(&strands[head_to]) < 2 * head_graphs) {
+        head_graphs += strand_graphs(&strands[head_to]);
+        head_to++;
+    }
+
+    if (tail_graphs <= head_graphs) {
+        blob    = collapse_strand_run(tc, s, tail_from, num);
+        strands = s->body.storage.strands;
+        strands[tail_from].blob_string = blob;
+        strands[tail_from].start       = 0;
+        strands[tail_from].end         = blob->body.num_graphs;
+        strands[tail_from].repetitions = 0;
+        s->body.num_strands = tail_from + 1;
+    }
+    else {
+        blob    = collapse_strand_run(tc, s, 0, head_to);
+        strands = s->body.storage.strands;
+        memmove(strands + 1, strands + head_to, (num - head_to) * sizeof(MVMStringStrand));
+        strands[0].blob_string = blob;
+        strands[0].start       = 0;
+        strands[0].end         = blob->body.num_graphs;
+        strands[0].repetitions = 0;
+        strands[0].offset      = 0;
+        s->body.num_strands = num - head_to + 1;
+    }
+    MVM_gc_write_barrier(tc, (MVMCollectable *)s, (MVMCollectable *)blob);
+}
+
 /* Takes a string that is no longer in NFG form after some concatenation-style
  * operation, and returns a new string that is in NFG. Note that we could do a
  * much, much, smarter thing in the future that doesn't involve all of this
  * copying and allocation and re-doing the whole string, but cases like this
  * should be fairly rare anyway, so go with simplicity for now. */
-static MVMString * re_nfg(MVMThreadContext *tc, MVMString *in) {
+MVMString * MVM_string_re_nfg(MVMThreadContext *tc, MVMString *in) {
     MVMNormalizer norm;
     MVMCodepointIter ci;
     MVMint32 ready;
@@ -195,16 +315,177 @@ MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString
     case MVM_STRING_GRAPHEME_8:
         return a->body.storage.blob_8[index];
     case MVM_STRING_STRAND: {
-        MVMGraphemeIter gi;
-        MVM_string_gi_init(tc, &gi, a);
-        MVM_string_gi_move_to(tc, &gi, index);
-        return MVM_string_gi_get_grapheme(tc, &gi);
+        /* Binary search for the strand, then index straight into its blob. */
+        MVMStringStrand *strands = a->body.storage.strands;
+        MVMStringStrand *ss = &strands[MVM_string_find_strand(tc, strands, a->body.num_strands, index)];
+        MVMStringIndex   pos = ss->start + (MVMStringIndex)(index - ss->offset) % (ss->end - ss->start);
+        switch (ss->blob_string->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32:
+            return ss->blob_string->body.storage.blob_32[pos];
+        case MVM_STRING_GRAPHEME_ASCII:
+            return ss->blob_string->body.storage.blob_ascii[pos];
+        case MVM_STRING_GRAPHEME_8:
+            return ss->blob_string->body.storage.blob_8[pos];
+        }
     }
     default:
         MVM_exception_throw_adhoc(tc, "String corruption detected: bad storage type");
     }
 }
 
+/* Haystacks that aren't flat 32-bit strings get searched by copying them, a
+ * window of this many graphemes (plus the needle's length, less one) at a
+ * time, into a 32-bit buffer. */
+#define MVM_STRING_SEARCH_WINDOW 4096
+
+/* Gets the graphemes of a string as a flat 32-bit buffer. If the string is
+ * already one, it's returned as it is; otherwise a copy is made, which the
+ * caller must free if *copied is set. */
+static MVMGrapheme32 * graphemes_32(MVMThreadContext *tc, MVMString *s, MVMint32 *copied) {
+    MVMStringIndex  graphs = MVM_string_graphs_nocheck(tc, s);
+    MVMGrapheme32  *buffer;
+    MVMGraphemeIter gi;
+    MVMStringIndex  i;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        *copied = 0;
+        return s->body.storage.blob_32;
+    }
+    buffer = MVM_malloc(graphs * sizeof(MVMGrapheme32));
+    MVM_string_gi_init(tc, &gi, s);
+    for (i = 0; i < graphs; i++)
+        buffer[i] = MVM_string_gi_get_grapheme(tc, &gi);
+    *copied = 1;
+    return buffer;
+}
+
+/* Boyer-Moore-Horspool search over graphemes, finding the first match of the
+ * needle that starts at or before last. The shift table is indexed by the
+ * low byte of a grapheme; where several needle graphemes share a low byte we
+ * take the smallest shift, which is always safe. A reverse table gives the
+ * shifts for searching from the end, finding the last match starting at or
+ * after first. Both return -1 if there is none. */
+typedef struct {
+    MVMGrapheme32 *needle;
+    MVMStringIndex length;
+    MVMuint32      shift[256];
+} GraphemeSearch;
+static void search_init(GraphemeSearch *gs, MVMGrapheme32 *needle, MVMStringIndex length, MVMint32 reverse) {
+    MVMStringIndex i;
+    gs->needle = needle;
+    gs->length = length;
+    for (i = 0; i < 256; i++)
+        gs->shift[i] = length;
+    if (reverse) {
+        for (i = length - 1; i > 0; i--)
+            gs->shift[(MVMuint8)needle[i]] = i;
+    }
+    else {
+        for (i = 0; i + 1 < length; i++)
+            gs->shift[(MVMuint8)needle[i]] = length - 1 - i;
+    }
+}
+static MVMint64 search_forward(GraphemeSearch *gs, const MVMGrapheme32 *h, MVMint64 last) {
+    const MVMGrapheme32 *n     = gs->needle;
+    MVMStringIndex       m     = gs->length;
+    MVMGrapheme32        final = n[m - 1];
+    MVMint64             i     = 0;
+    while (i <= last) {
+        MVMGrapheme32 g = h[i + m - 1];
+        if (g == final && memcmp(h + i, n, (m - 1) * sizeof(MVMGrapheme32)) == 0)
+            return i;
+        i += gs->shift[(MVMuint8)g];
+    }
+    return -1;
+}
+static MVMint64 search_backward(GraphemeSearch *gs, const MVMGrapheme32 *h, MVMint64 first, MVMint64 i) {
+    const MVMGrapheme32 *n       = gs->needle;
+    MVMStringIndex       m       = gs->length;
+    MVMGrapheme32        initial = n[0];
+    while (i >= first) {
+        MVMGrapheme32 g = h[i];
+        if (g == initial && memcmp(h + i + 1, n + 1, (m - 1) * sizeof(MVMGrapheme32)) == 0)
+            return i;
+        i -= gs->shift[(MVMuint8)g];
+    }
+    return -1;
+}
+
+/* Searches for a needle in a haystack of any storage type, returning the
+ * first (or, if reverse is set, the last) index from first to last that a
+ * match starts at, or -1. The caller ensures the needle fits at last. */
+static MVMint64 search_graphemes(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle,
+        MVMint64 first, MVMint64 last, MVMint32 reverse) {
+    GraphemeSearch  gs;
+    MVMStringIndex  n_graphs = MVM_string_graphs_nocheck(tc, needle);
+    MVMint32        needle_copied;
+    MVMGrapheme32  *n = graphemes_32(tc, needle, &needle_copied);
+    MVMint64        result = -1;
+
+    search_init(&gs, n, n_graphs, reverse);
+    if (Haystack->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32 *h = Haystack->body.storage.blob_32;
+        result = reverse
+            ? search_backward(&gs, h, first, last)
+            : search_forward(&gs, h + first, last - first);
+        if (result >= 0 && !reverse)
+            result += first;
+    }
+    else {
+        MVMGrapheme32  *buffer = MVM_malloc((MVM_STRING_SEARCH_WINDOW + n_graphs - 1) * sizeof(MVMGrapheme32));
+        MVMGraphemeIter gi;
+        if (reverse) {
+            /* Windows working back from the end; the iterator only moves
+             * forward, so we start a fresh one for each. */
+            MVMint64 hi = last;
+            while (hi >= first) {
+                MVMint64 lo = hi - MVM_STRING_SEARCH_WINDOW + 1;
+                MVMint64 i;
+                if (lo < first)
+                    lo = first;
+                MVM_string_gi_init(tc, &gi, Haystack);
+                MVM_string_gi_move_to(tc, &gi, lo);
+                for (i = 0; i < hi - lo + n_graphs; i++)
+                    buffer[i] = MVM_string_gi_get_grapheme(tc, &gi);
+                result = search_backward(&gs, buffer, 0, hi - lo);
+                if (result >= 0) {
+                    result += lo;
+                    break;
+                }
+                hi = lo - 1;
+            }
+        }
+        else {
+            /* Windows working forward, each starting with the last needle
+             * length less one graphemes of the one before. */
+            MVMint64 lo   = first;
+            MVMint64 have = 0;
+            MVM_string_gi_init(tc, &gi, Haystack);
+            MVM_string_gi_move_to(tc, &gi, first);
+            while (lo <= last) {
+                MVMint64 hi = lo + MVM_STRING_SEARCH_WINDOW - 1;
+                MVMint64 i;
+                if (hi > last)
+                    hi = last;
+                for (i = have; i < hi - lo + n_graphs; i++)
+                    buffer[i] = MVM_string_gi_get_grapheme(tc, &gi);
+                result = search_forward(&gs, buffer, hi - lo);
+                if (result >= 0) {
+                    result += lo;
+                    break;
+                }
+                have = n_graphs - 1;
+                memmove(buffer, buffer + (hi - lo + 1), have * sizeof(MVMGrapheme32));
+                lo = hi + 1;
+            }
+        }
+        MVM_free(buffer);
+    }
+
+    if (needle_copied)
+        MVM_free(n);
+    return result;
+}
+
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
     size_t index           = (size_t)start;
@@ -265,22 +546,40 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
                 else
                     return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
             }
+            else if (needle->body.storage_type == MVM_STRING_GRAPHEME_32) {
+                /* A needle with a grapheme that needs 32 bits can't be in an
+                 * 8-bit haystack; otherwise narrow it and use memmem. */
+                MVMGrapheme8 *narrow = MVM_malloc(n_graphs);
+                void         *mm_return_8;
+                MVMStringIndex i;
+                for (i = 0; i < n_graphs; i++) {
+                    if (!can_fit_into_8bit(needle->body.storage.blob_32[i])) {
+                        MVM_free(narrow);
+                        return -1;
+                    }
+                    narrow[i] = needle->body.storage.blob_32[i];
+                }
+                mm_return_8 = MVM_memmem(
+                    Haystack->body.storage.blob_8 + start,
+                    (H_graphs - start) * sizeof(MVMGrapheme8),
+                    narrow,
+                    n_graphs * sizeof(MVMGrapheme8)
+                );
+                MVM_free(narrow);
+                return mm_return_8 == NULL
+                    ? -1
+                    : (MVMGrapheme8*)mm_return_8 - Haystack->body.storage.blob_8;
+            }
             break;
     }
 
-    /* brute force for now. horrible, yes. halp. */
-    while (index <= H_graphs - n_graphs) {
-        if (MVM_string_substrings_equal_nocheck(tc, needle, 0, n_graphs, Haystack, index)) {
-            return (MVMint64)index;
-        }
-        index++;
-    }
-    return -1;
+    if (index > H_graphs - n_graphs)
+        return -1;
+    return search_graphemes(tc, Haystack, needle, index, H_graphs - n_graphs, 0);
 }
 
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index_from_end(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
-    MVMint64 result = -1;
     size_t index;
     MVMStringIndex H_graphs, n_graphs;
 
@@ -315,14 +614,52 @@ MVMint64 MVM_string_index_from_end(MVMThreadContext *tc, MVMString *Haystack, MV
         index = H_graphs - n_graphs;
     }
 
-    /* brute force for now. horrible, yes. halp. */
-    do {
-        if (MVM_string_substrings_equal_nocheck(tc, needle, 0, n_graphs, Haystack, index)) {
-            result = (MVMint64)index;
-            break;
-        }
-    } while (index-- > 0);
-    return result;
+    return search_graphemes(tc, Haystack, needle, 0, index, 1);
+}
+
+/* Tries to make a substring of a strand string into a view onto the strands
+ * it covers, finding the first of them by binary search on the offsets. We
+ * can do so if it lies within a single repetition of one strand, or if none
+ * of the strands it covers are repeated. Returns zero if we can't. */
+static MVMint32 substring_strand_view(MVMThreadContext *tc, MVMString *a, MVMString *result,
+        MVMint64 start_pos, MVMint64 end_pos) {
+    MVMStringStrand *strands = a->body.storage.strands;
+    MVMuint16        first   = MVM_string_find_strand(tc, strands, a->body.num_strands, start_pos);
+    MVMuint16        last    = MVM_string_find_strand(tc, strands, a->body.num_strands, end_pos - 1);
+    MVMStringStrand *ss      = &strands[first];
+    MVMuint16        i;
+
+    if (first == last) {
+        MVMuint32 len   = ss->end - ss->start;
+        MVMuint32 start = (MVMuint32)(start_pos - ss->offset) % len;
+        if (start + (end_pos - start_pos) > len)
+            return 0;
+        result->body.storage_type    = MVM_STRING_STRAND;
+        result->body.storage.strands = allocate_strands(tc, 1);
+        result->body.num_strands     = 1;
+        result->body.storage.strands[0].blob_string = ss->blob_string;
+        result->body.storage.strands[0].start       = ss->start + start;
+        result->body.storage.strands[0].end         = ss->start + start + (MVMuint32)(end_pos - start_pos);
+        result->body.storage.strands[0].repetitions = 0;
+        result->body.storage.strands[0].offset      = 0;
+        return 1;
+    }
+
+    for (i = first; i <= last; i++)
+        if (strands[i].repetitions)
+            return 0;
+    result->body.storage_type    = MVM_STRING_STRAND;
+    result->body.storage.strands = allocate_strands(tc, last - first + 1);
+    result->body.num_strands     = last - first + 1;
+    memcpy(result->body.storage.strands, strands + first,
+        (last - first + 1) * sizeof(MVMStringStrand));
+    for (i = 0; i < result->body.num_strands; i++)
+        result->body.storage.strands[i].offset -= (MVMStringIndex)start_pos;
+    result->body.storage.strands[0].start += (MVMStringIndex)(start_pos - ss->offset);
+    result->body.storage.strands[0].offset = 0;
+    result->body.storage.strands[last - first].end -=
+        (MVMStringIndex)(strands[last].offset + (strands[last].end - strands[last].start) - end_pos);
+    return 1;
 }
 
 /* Returns a substring of the given string */
@@ -379,18 +716,10 @@ MVMString * MVM_string_substring(MVMThreadContext *tc, MVMString *a, MVMint64 of
             result->body.storage.strands[0].start       = start_pos;
             result->body.storage.strands[0].end         = end_pos;
             result->body.storage.strands[0].repetitions = 0;
+            result->body.storage.strands[0].offset      = 0;
         }
-        else if (a->body.num_strands == 1 && a->body.storage.strands[0].repetitions == 0) {
-            /* Single strand string; quite possibly already a substring. We'll
-             * just produce an updated view. */
-            MVMStringStrand *orig_strand = &(a->body.storage.strands[0]);
-            result->body.storage_type    = MVM_STRING_STRAND;
-            result->body.storage.strands = allocate_strands(tc, 1);
-            result->body.num_strands     = 1;
-            result->body.storage.strands[0].blob_string = orig_strand->blob_string;
-            result->body.storage.strands[0].start       = orig_strand->start + start_pos;
-            result->body.storage.strands[0].end         = orig_strand->start + end_pos;
-            result->body.storage.strands[0].repetitions = 0;
+        else if (substring_strand_view(tc, a, result, start_pos, end_pos)) {
+            /* The range covers strands we can take a view into, so we did. */
         }
         else {
             /* Produce a new blob string, collapsing the strands. */
@@ -495,58 +824,55 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
 
         /* Otherwise, construct a new strand string. */
         else {
-            /* See if we have too many strands between the two. If so, we will
-             * collapse the biggest side. */
             MVMuint16 strands_a = a->body.storage_type == MVM_STRING_STRAND
                 ? a->body.num_strands
                 : 1;
             MVMuint16 strands_b = b->body.storage_type == MVM_STRING_STRAND
                 ? b->body.num_strands
                 : 1;
-            MVMString *effective_a = a;
-            MVMString *effective_b = b;
-            if (strands_a + strands_b > MVM_STRING_MAX_STRANDS) {
-                MVMROOT(tc, result, {
-                    if (strands_a >= strands_b) {
-                        effective_a = collapse_strands(tc, effective_a);
-                        strands_a   = 1;
-                    }
-                    else {
-                        effective_b = collapse_strands(tc, effective_b);
-                        strands_b   = 1;
-                    }
-                });
-            }
 
             /* Assemble the result. */
             result->body.num_strands = strands_a + strands_b;
             result->body.storage.strands = allocate_strands(tc, strands_a + strands_b);
-            if (effective_a->body.storage_type == MVM_STRING_STRAND) {
-                copy_strands(tc, effective_a, 0, result, 0, strands_a);
+            if (a->body.storage_type == MVM_STRING_STRAND) {
+                copy_strands(tc, a, 0, result, 0, strands_a);
             }
             else {
                 MVMStringStrand *ss = &(result->body.storage.strands[0]);
-                ss->blob_string = effective_a;
+                ss->blob_string = a;
                 ss->start       = 0;
-                ss->end         = effective_a->body.num_graphs;
+                ss->end         = a->body.num_graphs;
                 ss->repetitions = 0;
+                ss->offset      = 0;
             }
-            if (effective_b->body.storage_type == MVM_STRING_STRAND) {
-                copy_strands(tc, effective_b, 0, result, strands_a, strands_b);
+            if (b->body.storage_type == MVM_STRING_STRAND) {
+                MVMuint16 i;
+                copy_strands(tc, b, 0, result, strands_a, strands_b);
+                for (i = strands_a; i < strands_a + strands_b; i++)
+                    result->body.storage.strands[i].offset += agraphs;
             }
             else {
                 MVMStringStrand *ss = &(result->body.storage.strands[strands_a]);
-                ss->blob_string = effective_b;
+                ss->blob_string = b;
                 ss->start       = 0;
-                ss->end         = effective_b->body.num_graphs;
+                ss->end         = b->body.num_graphs;
                 ss->repetitions = 0;
+                ss->offset      = agraphs;
+            }
+
+            /* If that's too many strands, collapse some of them. */
+            if (result->body.num_strands > MVM_STRING_MAX_STRANDS) {
+                MVMROOT(tc, result, {
+                    while (result->body.num_strands > MVM_STRING_MAX_STRANDS)
+                        collapse_strand_end(tc, result);
+                });
             }
         }
     });
     });
 
     STRAND_CHECK(tc, result);
-    return MVM_nfg_is_concat_stable(tc, a, b) ? result : re_nfg(tc, result);
+    return MVM_nfg_is_concat_stable(tc, a, b) ? result : MVM_string_re_nfg(tc, result);
 }
 
 MVMString * MVM_string_repeat(MVMThreadContext *tc, MVMString *a, MVMint64 count) {
@@ -603,6 +929,7 @@ MVMString * MVM_string_repeat(MVMThreadContext *tc, MVMString *a, MVMint64 count
             result->body.storage.strands[0].end         = agraphs;
         }
         result->body.storage.strands[0].repetitions = count - 1;
+        result->body.storage.strands[0].offset      = 0;
         result->body.num_strands = 1;
     });
 
@@ -630,6 +957,11 @@ static MVMGrapheme32 ord_getbasechar (MVMThreadContext *tc, MVMGrapheme32 g) {
     MVMGrapheme32 return_g;
     MVMint32 ready;
     MVMNormalizer norm;
+
+    /* Nothing below this decomposes, so it's its own base character. */
+    if (0 <= g && g < MVM_NORMALIZE_FIRST_SIG_NFD)
+        return g;
+
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFD);
 
     ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, g, &return_g);
@@ -659,6 +991,23 @@ MVMint64 MVM_string_equal_at(MVMThreadContext *tc, MVMString *a, MVMString *b, M
         return 0;
     return MVM_string_substrings_equal_nocheck(tc, a, offset, bgraphs, b, 0);
 }
+/* Case changes within latin-1 are one-to-one, and titlecase is the same as
+ * uppercase, apart from for MICRO SIGN, SHARP S and Y WITH DIAERESIS, whose
+ * changes go outside of latin-1 or expand. This does the rest without going
+ * to the Unicode database; check latin1_case_simple first. */
+#define latin1_case_simple(g) ((g) >= 0 && (g) < 0x100 && (g) != 0xB5 && (g) != 0xDF && (g) != 0xFF)
+MVM_STATIC_INLINE MVMGrapheme32 latin1_case_change(MVMGrapheme32 g, MVMint32 type) {
+    if (type == MVM_unicode_case_change_type_upper || type == MVM_unicode_case_change_type_title) {
+        if ((g >= 'a' && g <= 'z') || (g >= 0xE0 && g <= 0xFE && g != 0xF7))
+            return g - 0x20;
+    }
+    else {
+        if ((g >= 'A' && g <= 'Z') || (g >= 0xC0 && g <= 0xDE && g != 0xD7))
+            return g + 0x20;
+    }
+    return g;
+}
+
 /* Ensure return value can hold numbers at least 3x higher than MVMStringIndex.
  * Theoretically if the string has all ﬃ ligatures and 1/3 the max size of
  * MVMStringIndex in length, we could have some weird results. */
@@ -675,6 +1024,18 @@ MVM_STATIC_INLINE MVMint64 string_equal_at_ignore_case_INTERNAL_loop(MVMThreadCo
     for (i = 0; i + H_start < H_graphs && i + n_offset < n_fc_graphs; i++) {
         const MVMCodepoint* H_result_cps;
         H_g = MVM_string_get_grapheme_at_nocheck(tc, Haystack, H_start + i);
+        if (latin1_case_simple(H_g)) {
+            /* Fold latin-1 on the fly; it never expands. */
+            n_g = MVM_string_get_grapheme_at_nocheck(tc, needle_fc, i + n_offset);
+            H_g = latin1_case_change(H_g, MVM_unicode_case_change_type_fold);
+            if (ignoremark) {
+                H_g = ord_getbasechar(tc, H_g);
+                n_g = ord_getbasechar(tc, n_g);
+            }
+            if (H_g != n_g)
+                return -1;
+            continue;
+        }
         if (H_g >= 0 ) {
             /* For codeponits we can get the case change directly */
             H_fc_cps = MVM_unicode_get_case_change(tc, H_g, MVM_unicode_case_change_type_fold, &H_result_cps);
@@ -907,22 +1268,102 @@ MVMint64 MVM_string_index_of_grapheme(MVMThreadContext *tc, MVMString *a, MVMGra
 
 /* Case change functions. */
 static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
+
+/* Changes the case of an ASCII run of 8-bit graphemes, returning non-zero if
+ * anything changed. The loop has no branches, so the compiler can vectorize
+ * it. */
+static MVMint32 ascii_case_change(MVMGrapheme8 *out, const MVMGrapheme8 *in, MVMStringIndex length, MVMint32 type) {
+    MVMuint8       from    = type == MVM_unicode_case_change_type_upper || type == MVM_unicode_case_change_type_title
+                           ? 'a' : 'A';
+    MVMuint8       changed = 0;
+    MVMStringIndex i;
+    for (i = 0; i < length; i++) {
+        MVMuint8 c    = (MVMuint8)in[i];
+        MVMuint8 flip = ((MVMuint8)(c - from) < 26) << 5;
+        out[i]   = c ^ flip;
+        changed |= flip;
+    }
+    return changed;
+}
+
+/* Tries to change the case of a string made up only of ASCII graphemes in
+ * 8-bit storage, flat or in strands. Returns NULL if the string isn't one
+ * of those, or the string itself if nothing changed. */
+static MVMString * do_ascii_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 type, MVMint64 sgraphs) {
+    MVMGrapheme8 *buffer;
+    MVMint32      changed = 0;
+    MVMString    *result;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        MVMint64 i;
+        for (i = 0; i < sgraphs; i++)
+            if (s->body.storage.blob_8[i] < 0)
+                return NULL;
+        buffer  = MVM_malloc(sgraphs);
+        changed = ascii_case_change(buffer, s->body.storage.blob_8, sgraphs, type);
+    }
+    else if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMint64  pos = 0;
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *ss = &(s->body.storage.strands[i]);
+            MVMStringIndex   j;
+            if (ss->blob_string->body.storage_type != MVM_STRING_GRAPHEME_8)
+                return NULL;
+            for (j = ss->start; j < ss->end; j++)
+                if (ss->blob_string->body.storage.blob_8[j] < 0)
+                    return NULL;
+        }
+        buffer = MVM_malloc(sgraphs);
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMStringStrand *ss = &(s->body.storage.strands[i]);
+            MVMuint32        rep;
+            for (rep = 0; rep <= ss->repetitions; rep++) {
+                changed |= ascii_case_change(buffer + pos,
+                    ss->blob_string->body.storage.blob_8 + ss->start, ss->end - ss->start, type);
+                pos += ss->end - ss->start;
+            }
+        }
+    }
+    else {
+        return NULL;
+    }
+
+    if (!changed) {
+        MVM_free(buffer);
+        return s;
+    }
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.num_graphs     = sgraphs;
+    result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+    result->body.storage.blob_8 = buffer;
+    return result;
+}
+
 static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 type, char *error) {
     MVMint64 sgraphs;
     MVM_string_check_arg(tc, s, error);
     sgraphs = MVM_string_graphs(tc, s);
     if (sgraphs) {
-        MVMString *result;
+        MVMString *result = do_ascii_case_change(tc, s, type, sgraphs);
         MVMGraphemeIter gi;
         MVMint64 result_graphs = sgraphs;
-        MVMGrapheme32 *result_buf = MVM_malloc(result_graphs * sizeof(MVMGrapheme32));
+        MVMGrapheme32 *result_buf;
         MVMint32 changed = 0;
         MVMint64 i = 0;
+        if (result)
+            return result;
+        result_buf = MVM_malloc(result_graphs * sizeof(MVMGrapheme32));
         MVM_string_gi_init(tc, &gi, s);
         while (MVM_string_gi_has_more(tc, &gi)) {
             MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
           peeked:
-            if (g == 0x03A3) {
+            if (latin1_case_simple(g)) {
+                MVMGrapheme32 changed_g = latin1_case_change(g, type);
+                if (changed_g != g)
+                    changed = 1;
+                result_buf[i++] = changed_g;
+            }
+            else if (g == 0x03A3) {
                 /* Greek sigma needs special handling when lowercased. */
                 switch (type) {
                     case MVM_unicode_case_change_type_upper:
@@ -1180,6 +1621,59 @@ MVMString * MVM_string_decode_from_buf(MVMThreadContext *tc, MVMObject *buf, MVM
         encoding_flag);
 }
 
+/* Finds the next occurrence of a grapheme in a flat string, from the given
+ * position, returning end if there isn't one. */
+static MVMStringIndex find_grapheme_flat(MVMThreadContext *tc, MVMString *s, MVMGrapheme32 g,
+        MVMStringIndex from, MVMStringIndex end) {
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        MVMGrapheme8 *blob = s->body.storage.blob_8;
+        MVMGrapheme8 *found;
+        if (!can_fit_into_8bit(g))
+            return end;
+        found = memchr(blob + from, (MVMuint8)g, end - from);
+        return found ? (MVMStringIndex)(found - blob) : end;
+    }
+    else {
+        MVMGrapheme32 *blob = s->body.storage.blob_32;
+        while (from < end && blob[from] != g)
+            from++;
+        return from;
+    }
+}
+
+/* Splits a flat string on a single grapheme. We count the separators with
+ * memchr first, so the result array can be sized once, then make each of
+ * the pieces as a view onto the input. */
+static void split_on_grapheme(MVMThreadContext *tc, MVMHLLConfig *hll, MVMObject *result,
+        MVMString *input, MVMGrapheme32 sep) {
+    MVMStringIndex end   = MVM_string_graphs_nocheck(tc, input);
+    MVMStringIndex start = 0;
+    MVMint64       count = 0;
+    MVMint64       i;
+
+    while ((start = find_grapheme_flat(tc, input, sep, start, end)) < end) {
+        count++;
+        start++;
+    }
+
+    MVMROOT(tc, input, {
+    MVMROOT(tc, result, {
+        MVM_repr_pos_set_elems(tc, result, count + 1);
+        start = 0;
+        for (i = 0; i <= count; i++) {
+            MVMStringIndex index = find_grapheme_flat(tc, input, sep, start, end);
+            MVMString *portion   = MVM_string_substring(tc, input, start, index - start);
+            MVMROOT(tc, portion, {
+                MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
+                MVM_repr_set_str(tc, pobj, portion);
+                MVM_repr_bind_pos_o(tc, result, i, pobj);
+            });
+            start = index + 1;
+        }
+    });
+    });
+}
+
 MVMObject * MVM_string_split(MVMThreadContext *tc, MVMString *separator, MVMString *input) {
     MVMObject *result;
     MVMStringIndex start, end, sep_length;
@@ -1196,29 +1690,36 @@ MVMObject * MVM_string_split(MVMThreadContext *tc, MVMString *separator, MVMStri
             end = MVM_string_graphs_nocheck(tc, input);
             sep_length = MVM_string_graphs_nocheck(tc, separator);
 
-            while (start < end) {
-                MVMString *portion;
-                MVMStringIndex index;
-                MVMStringIndex length;
-
-                /* XXX make this use the dual-traverse iterator, but such that it
-                    can reset the index of what it's comparing... <!> */
-                index = MVM_string_index(tc, input, separator, start);
-                length = sep_length ? (index == -1 ? end : index) - start : 1;
-                if (length > 0 || (sep_length && length == 0)) {
-                    portion = MVM_string_substring(tc, input, start, length);
-                    MVMROOT(tc, portion, {
+            if (sep_length == 1 && end > 0 && (input->body.storage_type == MVM_STRING_GRAPHEME_8
+                    || input->body.storage_type == MVM_STRING_GRAPHEME_32)) {
+                split_on_grapheme(tc, hll, result, input,
+                    MVM_string_get_grapheme_at_nocheck(tc, separator, 0));
+            }
+            else {
+                while (start < end) {
+                    MVMString *portion;
+                    MVMStringIndex index;
+                    MVMStringIndex length;
+
+                    /* XXX make this use the dual-traverse iterator, but such that it
+                        can reset the index of what it's comparing... <!> */
+                    index = MVM_string_index(tc, input, separator, start);
+                    length = sep_length ? (index == -1 ? end : index) - start : 1;
+                    if (length > 0 || (sep_length && length == 0)) {
+                        portion = MVM_string_substring(tc, input, start, length);
+                        MVMROOT(tc, portion, {
+                            MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
+                            MVM_repr_set_str(tc, pobj, portion);
+                            MVM_repr_push_o(tc, result, pobj);
+                        });
+                    }
+                    start += length + sep_length;
+                    /* Gather an empty string if the delimiter is found at the end. */
+                    if (sep_length && start == end) {
                         MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
-                        MVM_repr_set_str(tc, pobj, portion);
+                        MVM_repr_set_str(tc, pobj, tc->instance->str_consts.empty);
                         MVM_repr_push_o(tc, result, pobj);
-                    });
-                }
-                start += length + sep_length;
-                /* Gather an empty string if the delimiter is found at the end. */
-                if (sep_length && start == end) {
-                    MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
-                    MVM_repr_set_str(tc, pobj, tc->instance->str_consts.empty);
-                    MVM_repr_push_o(tc, result, pobj);
+                    }
                 }
             }
         });
@@ -1395,7 +1896,7 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
 
     MVM_free(pieces);
     STRAND_CHECK(tc, result);
-    return concats_stable ? result : re_nfg(tc, result);
+    return concats_stable ? result : MVM_string_re_nfg(tc, result);
 }
 
 /* Returning nonzero means it found the char at the position specified in 'a' in 'b'.
@@ -1771,11 +2272,26 @@ static MVMint64 UPV_Pi = 0;
 static MVMint64 UPV_Pf = 0;
 static MVMint64 UPV_Po = 0;
 
+/* For each codepoint in the latin-1 range, the character classes that it is
+ * a member of, ORed together; the class constants are all single bits. */
+static MVMuint16 latin1_cclass[256];
+
 /* concatenating with "" ensures that only literal strings are accepted as argument. */
 #define STR_WITH_LEN(str)  ("" str ""), (sizeof(str) - 1)
 
-/* Resolves various unicode property values that we'll need. */
+/* Resolves various unicode property values that we'll need, and then works
+ * out the character classes of the latin-1 range. */
 void MVM_string_cclass_init(MVMThreadContext *tc) {
+    static const MVMint64 cclasses[] = {
+        MVM_CCLASS_UPPERCASE, MVM_CCLASS_LOWERCASE, MVM_CCLASS_ALPHABETIC,
+        MVM_CCLASS_NUMERIC, MVM_CCLASS_HEXADECIMAL, MVM_CCLASS_WHITESPACE,
+        MVM_CCLASS_PRINTING, MVM_CCLASS_BLANK, MVM_CCLASS_CONTROL,
+        MVM_CCLASS_PUNCTUATION, MVM_CCLASS_ALPHANUMERIC, MVM_CCLASS_NEWLINE,
+        MVM_CCLASS_WORD
+    };
+    MVMGrapheme32 cp;
+    size_t        i;
+
     UPV_Nd = MVM_unicode_cname_to_property_value_code(tc,
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Nd"));
     UPV_Lu = MVM_unicode_cname_to_property_value_code(tc,
@@ -1806,6 +2322,14 @@ void MVM_string_cclass_init(MVMThreadContext *tc) {
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Pf"));
     UPV_Po = MVM_unicode_cname_to_property_value_code(tc,
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Po"));
+
+    for (cp = 0; cp < 256; cp++) {
+        MVMuint16 bits = 0;
+        for (i = 0; i < sizeof(cclasses) / sizeof(MVMint64); i++)
+            if (grapheme_is_cclass(tc, cclasses[i], cp))
+                bits |= (MVMuint16)cclasses[i];
+        latin1_cclass[cp] = bits;
+    }
 }
 
 /* Checks if the specified grapheme is in the given character class. */
@@ -1929,6 +2453,31 @@ static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGra
     }
 }
 
+/* Gets the bits to test in latin1_cclass for a character class. Every
+ * codepoint is either a control or a printing one, so for the any class we
+ * can just test all the bits; something that isn't a known class gets no
+ * bits, matching grapheme_is_cclass. */
+static MVMuint16 cclass_mask(MVMint64 cclass) {
+    MVMint64 known = MVM_CCLASS_UPPERCASE | MVM_CCLASS_LOWERCASE | MVM_CCLASS_ALPHABETIC
+        | MVM_CCLASS_NUMERIC | MVM_CCLASS_HEXADECIMAL | MVM_CCLASS_WHITESPACE
+        | MVM_CCLASS_PRINTING | MVM_CCLASS_BLANK | MVM_CCLASS_CONTROL
+        | MVM_CCLASS_PUNCTUATION | MVM_CCLASS_ALPHANUMERIC | MVM_CCLASS_NEWLINE
+        | MVM_CCLASS_WORD;
+    if (cclass == MVM_CCLASS_ANY)
+        return 0xFFFF;
+    if (cclass > 0 && (cclass & known) == cclass && (cclass & (cclass - 1)) == 0)
+        return (MVMuint16)cclass;
+    return 0;
+}
+
+/* Checks if a grapheme is in a character class, using the precomputed
+ * classes when it's in the latin-1 range. */
+MVM_STATIC_INLINE MVMint64 in_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMuint16 mask, MVMGrapheme32 g) {
+    if (g >= 0 && g < 256)
+        return (latin1_cclass[g] & mask) != 0;
+    return grapheme_is_cclass(tc, cclass, g) != 0;
+}
+
 /* Checks if the character at the specified offset is a member of the
  * indicated character class. */
 MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset) {
@@ -1937,55 +2486,97 @@ MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *
     if (offset < 0 || offset >= MVM_string_graphs_nocheck(tc, s))
         return 0;
     g = MVM_string_get_grapheme_at_nocheck(tc, s, offset);
-    return grapheme_is_cclass(tc, cclass, g);
+    return in_cclass(tc, cclass, cclass_mask(cclass), g);
 }
 
-/* Searches for the next char that is in the specified character class. */
-MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset, MVMint64 count) {
-    MVMGraphemeIter gi;
-    MVMint64        length, end, pos;
+/* Finds the first grapheme from start up to end in a flat string that is
+ * (if want is 1) or is not (if want is 0) in the character class; returns
+ * its position, or end if there is none. For 8-bit storage, everything but
+ * synthetics is a single table lookup. */
+static MVMint64 find_cclass_flat(MVMThreadContext *tc, MVMint64 cclass, MVMuint16 mask,
+        MVMint64 want, MVMString *s, MVMint64 start, MVMint64 end) {
+    MVMint64 pos;
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        const MVMGrapheme8 *blob = s->body.storage.blob_8;
+        for (pos = start; pos < end; pos++) {
+            MVMGrapheme8 g = blob[pos];
+            if (g >= 0) {
+                if (((latin1_cclass[g] & mask) != 0) == want)
+                    return pos;
+            }
+            else if ((grapheme_is_cclass(tc, cclass, g) != 0) == want) {
+                return pos;
+            }
+        }
+    }
+    else {
+        const MVMGrapheme32 *blob = s->body.storage.blob_32;
+        for (pos = start; pos < end; pos++)
+            if (in_cclass(tc, cclass, mask, blob[pos]) == want)
+                return pos;
+    }
+    return end;
+}
 
-    MVM_string_check_arg(tc, s, "find_cclass");
+/* Finds the first grapheme in the given range of a string that is, or is
+ * not, in the character class. Strands are scanned directly in the blob of
+ * the string they refer to; once a whole repetition of a strand has been
+ * scanned with no match, the rest can be skipped, as they'll be the same. */
+static MVMint64 find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s,
+        MVMint64 offset, MVMint64 count, MVMint64 want) {
+    MVMint64  length = MVM_string_graphs_nocheck(tc, s);
+    MVMint64  end    = offset + count;
+    MVMuint16 mask   = cclass_mask(cclass);
+    MVMStringStrand *strands;
+    MVMuint16        num_strands, i;
 
-    length = MVM_string_graphs_nocheck(tc, s);
-    end    = offset + count;
     end = length < end ? length : end;
     if (offset < 0 || offset >= length)
         return end;
 
-    MVM_string_gi_init(tc, &gi, s);
-    MVM_string_gi_move_to(tc, &gi, offset);
-    for (pos = offset; pos < end; pos++) {
-        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
-        if (grapheme_is_cclass(tc, cclass, g) > 0)
-            return pos;
+    if (s->body.storage_type != MVM_STRING_STRAND)
+        return find_cclass_flat(tc, cclass, mask, want, s, offset, end);
+
+    strands     = s->body.storage.strands;
+    num_strands = s->body.num_strands;
+    for (i = MVM_string_find_strand(tc, strands, num_strands, offset); i < num_strands; i++) {
+        MVMStringStrand *ss       = &strands[i];
+        MVMint64         seg_len  = ss->end - ss->start;
+        MVMint64         from     = ss->offset;
+        MVMint64         reps     = (MVMint64)ss->repetitions + 1;
+        MVMint64         rep;
+        if (from >= end)
+            break;
+        for (rep = 0; rep < reps; rep++, from += seg_len) {
+            MVMint64 lo, hi, found;
+            if (from + seg_len <= offset)
+                continue;
+            if (from >= end)
+                return end;
+            lo    = offset > from ? offset - from : 0;
+            hi    = end - from < seg_len ? end - from : seg_len;
+            found = find_cclass_flat(tc, cclass, mask, want, ss->blob_string,
+                ss->start + lo, ss->start + hi);
+            if (found != ss->start + hi)
+                return from + found - ss->start;
+            if (lo == 0 && hi == seg_len)
+                break; /* A whole repetition missed, so later ones will too. */
+        }
     }
 
     return end;
 }
 
+/* Searches for the next char that is in the specified character class. */
+MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset, MVMint64 count) {
+    MVM_string_check_arg(tc, s, "find_cclass");
+    return find_cclass(tc, cclass, s, offset, count, 1);
+}
+
 /* Searches for the next char that is not in the specified character class. */
 MVMint64 MVM_string_find_not_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset, MVMint64 count) {
-    MVMGraphemeIter gi;
-    MVMint64        length, end, pos;
-
     MVM_string_check_arg(tc, s, "find_not_cclass");
-
-    length = MVM_string_graphs_nocheck(tc, s);
-    end    = offset + count;
-    end = length < end ? length : end;
-    if (offset < 0 || offset >= length)
-        return end;
-
-    MVM_string_gi_init(tc, &gi, s);
-    MVM_string_gi_move_to(tc, &gi, offset);
-    for (pos = offset; pos < end; pos++) {
-        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
-        if (grapheme_is_cclass(tc, cclass, g) == 0)
-            return pos;
-    }
-
-    return end;
+    return find_cclass(tc, cclass, s, offset, count, 0);
 }
 
 static MVMint16   encoding_name_init         = 0;
@@ -2084,70 +2675,143 @@ MVMString * MVM_string_chr(MVMThreadContext *tc, MVMCodepoint cp) {
     return s;
 }
 
+/* Sets up the key for string hashing. It's random per process, so that
+ * nobody can work out ahead of time which keys will collide in our hashes. */
+void MVM_string_hash_key_init(MVMInstance *instance) {
+    MVMuint64 key[2] = { 0, 0 };
+    MVMuint64 mix;
+    MVMint32  i;
+#ifndef _WIN32
+    FILE *fh = fopen("/dev/urandom", "rb");
+    if (fh) {
+        if (fread(key, sizeof(key), 1, fh) != 1)
+            key[0] = key[1] = 0;
+        fclose(fh);
+    }
+#endif
+
+    /* Mix in the time and where the instance and the stack live (with
+     * splitmix64), in case we could not read any randomness. */
+    mix = MVM_platform_now() ^ ((MVMuint64)(uintptr_t)instance << 16)
+        ^ ((MVMuint64)(uintptr_t)&mix << 32);
+    for (i = 0; i < 2; i++) {
+        MVMuint64 z = (mix += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        key[i] ^= z ^ (z >> 31);
+    }
+
+    instance->hash_key[0] = key[0];
+    instance->hash_key[1] = key[1];
+}
+
+/* State for SipHash-1-3 over the graphemes of a string. */
+typedef struct {
+    MVMuint64 v0, v1, v2, v3;
+
+    /* A grapheme waiting for the next one to make up a 64-bit block. */
+    MVMuint64 pending;
+    MVMint32  have_pending;
+} SipHashState;
+
+#define SIP_ROTL(x, b) (MVMuint64)(((x) << (b)) | ((x) >> (64 - (b))))
+#define SIP_ROUND(st) do { \
+    (st)->v0 += (st)->v1; (st)->v1 = SIP_ROTL((st)->v1, 13); \
+    (st)->v1 ^= (st)->v0; (st)->v0 = SIP_ROTL((st)->v0, 32); \
+    (st)->v2 += (st)->v3; (st)->v3 = SIP_ROTL((st)->v3, 16); \
+    (st)->v3 ^= (st)->v2; \
+    (st)->v0 += (st)->v3; (st)->v3 = SIP_ROTL((st)->v3, 21); \
+    (st)->v3 ^= (st)->v0; \
+    (st)->v2 += (st)->v1; (st)->v1 = SIP_ROTL((st)->v1, 17); \
+    (st)->v1 ^= (st)->v2; (st)->v2 = SIP_ROTL((st)->v2, 32); \
+} while (0)
+
+MVM_STATIC_INLINE void sip_block(SipHashState *st, MVMuint64 m) {
+    st->v3 ^= m;
+    SIP_ROUND(st);
+    st->v0 ^= m;
+}
+
+/* Feeds graphemes from start up to end of a flat string into the hash. We
+ * hash the graphemes as 32-bit values, whatever size they are stored at, so
+ * equal strings hash the same however they are stored. */
+static void sip_flat(MVMThreadContext *tc, SipHashState *st, MVMString *s,
+                     MVMStringIndex start, MVMStringIndex end) {
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32: {
+            const MVMGrapheme32 *graphs = s->body.storage.blob_32;
+            if (st->have_pending && start < end) {
+                sip_block(st, st->pending | ((MVMuint64)(MVMuint32)graphs[start++] << 32));
+                st->have_pending = 0;
+            }
+            for (; start + 1 < end; start += 2)
+                sip_block(st, (MVMuint64)(MVMuint32)graphs[start]
+                    | ((MVMuint64)(MVMuint32)graphs[start + 1] << 32));
+            if (start < end) {
+                st->pending = (MVMuint32)graphs[start];
+                st->have_pending = 1;
+            }
+            break;
+        }
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            const MVMGrapheme8 *graphs = s->body.storage.blob_8;
+            if (st->have_pending && start < end) {
+                sip_block(st, st->pending | ((MVMuint64)(MVMuint32)(MVMGrapheme32)graphs[start++] << 32));
+                st->have_pending = 0;
+            }
+            for (; start + 1 < end; start += 2)
+                sip_block(st, (MVMuint64)(MVMuint32)(MVMGrapheme32)graphs[start]
+                    | ((MVMuint64)(MVMuint32)(MVMGrapheme32)graphs[start + 1] << 32));
+            if (start < end) {
+                st->pending = (MVMuint32)(MVMGrapheme32)graphs[start];
+                st->have_pending = 1;
+            }
+            break;
+        }
+        default:
+            MVM_exception_throw_adhoc(tc, "Unknown string storage type in hash");
+    }
+}
+
 /* Takes a string and computes a hash code for it, storing it in the hash code
- * cache field of the string. Hashing code is derived from the Jenkins hash
- * implementation in uthash.h. */
-typedef union {
-    MVMint32 graphs[3];
-    unsigned char bytes[12];
-} MVMJenHashGraphemeView;
+ * cache field of the string. We use SipHash-1-3, keyed with the per-process
+ * key, over the graphemes of the string as 32-bit little-endian values, and
+ * fold the result down to 32 bits. */
 void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
-    /* The hash algorithm works in bytes. Since we can represent strings in a
-     * number of ways, and we want consistent hashing, then we'll read the
-     * strings using the grapheme iterator in groups of 3, using 32-bit ints
-     * for the graphemes no matter what the string really holds them as. Then
-     * we'll use the bytes view of that in the hashing function. */
-    MVMJenHashGraphemeView hash_block;
-    MVMGraphemeIter gi;
-    MVMuint32 graphs_remaining = MVM_string_graphs(tc, s);
+    MVMuint64    *key = tc->instance->hash_key;
+    MVMuint64     bytes = (MVMuint64)MVM_string_graphs(tc, s) * sizeof(MVMGrapheme32);
+    SipHashState  st;
+    MVMuint64     hash;
+
+    st.v0 = 0x736f6d6570736575ULL ^ key[0];
+    st.v1 = 0x646f72616e646f6dULL ^ key[1];
+    st.v2 = 0x6c7967656e657261ULL ^ key[0];
+    st.v3 = 0x7465646279746573ULL ^ key[1];
+    st.pending = 0;
+    st.have_pending = 0;
 
-    /* Initialize hash state. */
-    MVMuint32 hashv = 0xfeedbeef;
-    MVMuint32 _hj_i, _hj_j;
-    _hj_i = _hj_j = 0x9e3779b9;
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMStringStrand *strands = s->body.storage.strands;
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++) {
+            MVMuint32 rep;
+            for (rep = 0; rep <= strands[i].repetitions; rep++)
+                sip_flat(tc, &st, strands[i].blob_string, strands[i].start, strands[i].end);
+        }
+    }
+    else {
+        sip_flat(tc, &st, s, 0, s->body.num_graphs);
+    }
 
-    /* Work through the string 3 graphemes at a time. */
-    MVM_string_gi_init(tc, &gi, s);
-    while (graphs_remaining >= 3) {
-        hash_block.graphs[0] = MVM_string_gi_get_grapheme(tc, &gi);
-        hash_block.graphs[1] = MVM_string_gi_get_grapheme(tc, &gi);
-        hash_block.graphs[2] = MVM_string_gi_get_grapheme(tc, &gi);
-        _hj_i += (hash_block.bytes[0] + ( (unsigned)hash_block.bytes[1] << 8 )
-            + ( (unsigned)hash_block.bytes[2] << 16 )
-            + ( (unsigned)hash_block.bytes[3] << 24 ) );
-        _hj_j +=    (hash_block.bytes[4] + ( (unsigned)hash_block.bytes[5] << 8 )
-            + ( (unsigned)hash_block.bytes[6] << 16 )
-            + ( (unsigned)hash_block.bytes[7] << 24 ) );
-        hashv += (hash_block.bytes[8] + ( (unsigned)hash_block.bytes[9] << 8 )
-            + ( (unsigned)hash_block.bytes[10] << 16 )
-            + ( (unsigned)hash_block.bytes[11] << 24 ) );
-
-        HASH_JEN_MIX(_hj_i, _hj_j, hashv);
-
-        graphs_remaining -= 3;
-    }
-
-    /* Mix in key length (in bytes, not graphemes). */
-    hashv += MVM_string_graphs(tc, s) * sizeof(MVMGrapheme32);
-
-    /* Now handle trailing graphemes (must be 2, 1, or 0). */
-    switch (graphs_remaining) {
-        case 2:
-            hash_block.graphs[1] = MVM_string_gi_get_grapheme(tc, &gi);
-            _hj_j += ( (unsigned)hash_block.bytes[7] << 24 ) +
-                     ( (unsigned)hash_block.bytes[6] << 16 ) +
-                     ( (unsigned)hash_block.bytes[5] << 8 ) +
-                     hash_block.bytes[4];
-        /* Fallthrough */
-        case 1:
-            hash_block.graphs[0] = MVM_string_gi_get_grapheme(tc, &gi);
-            _hj_i += ( (unsigned)hash_block.bytes[3] << 24 ) +
-                     ( (unsigned)hash_block.bytes[2] << 16 ) +
-                     ( (unsigned)hash_block.bytes[1] << 8 ) +
-                     hash_block.bytes[0];
-    }
-    HASH_JEN_MIX(_hj_i, _hj_j, hashv);
+    /* The final block holds the length in bytes and any leftover grapheme. */
+    sip_block(&st, (bytes << 56) | (st.have_pending ? st.pending : 0));
+    st.v2 ^= 0xff;
+    SIP_ROUND(&st);
+    SIP_ROUND(&st);
+    SIP_ROUND(&st);
+    hash = st.v0 ^ st.v1 ^ st.v2 ^ st.v3;
 
     /* Store computed hash value. */
-    s->body.cached_hash_code = hashv;
+    s->body.cached_hash_code = (MVMint32)(hash ^ (hash >> 32));
 }
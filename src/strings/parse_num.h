@@ -1 +1,21 @@
 MVMnum64 MVM_coerce_s_n(MVMThreadContext *tc, MVMString *s);
+MVMnum64 MVM_parse_decimal_to_double(MVMuint64 w, MVMint64 q, int negative);
+
+/* Checks whether the eight graphemes starting at chars are all ASCII digits
+ * and, if so, puts their value into *value. The checks and conversion are
+ * done on all eight at once, in a 64-bit word. */
+MVM_STATIC_INLINE int MVM_parse_eight_digits(const MVMGrapheme8 *chars, MVMuint64 *value) {
+    MVMuint64 v = 0;
+    int       i;
+    for (i = 0; i < 8; i++)
+        v |= (MVMuint64)(MVMuint8)chars[i] << (8 * i);
+    if (((v & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL)
+        return 0;
+    v -= 0x3030303030303030ULL;
+    v  = v * 10 + (v >> 8);
+    v  = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+          ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    *value = v & 0xFFFFFFFFULL;
+    return 1;
+}
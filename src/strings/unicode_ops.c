@@ -363,6 +363,15 @@ MVMint32 MVM_unicode_name_to_property_code(MVMThreadContext *tc, MVMString *name
     return result ? result->codepoint : 0;
 }
 
+static uv_mutex_t property_hash_count_mutex;
+static int property_hash_count = 0;
+static uv_once_t property_hash_count_guard = UV_ONCE_INIT;
+
+static void setup_property_mutex(void)
+{
+    uv_mutex_init(&property_hash_count_mutex);
+}
+
 static void generate_unicode_property_values_hashes(MVMThreadContext *tc) {
     MVMUnicodeNameRegistry **hash_array = MVM_calloc(MVM_NUM_PROPERTY_CODES, sizeof(MVMUnicodeNameRegistry *));
     MVMuint32 index = 0;
@@ -399,7 +408,21 @@ static void generate_unicode_property_values_hashes(MVMThreadContext *tc) {
             hash_array[index] = binaries;
         }
     }
-    unicode_property_values_hashes = hash_array;
+    MVM_store(&unicode_property_values_hashes, hash_array);
+}
+
+/* Gets the hashes of property value names, building them the first time any
+ * is looked up rather than at startup, as many programs never do so. */
+static MVMUnicodeNameRegistry ** get_property_values_hashes(MVMThreadContext *tc) {
+    MVMUnicodeNameRegistry **hashes = (MVMUnicodeNameRegistry **)MVM_load(&unicode_property_values_hashes);
+    if (!hashes) {
+        uv_mutex_lock(&property_hash_count_mutex);
+        if (!unicode_property_values_hashes)
+            generate_unicode_property_values_hashes(tc);
+        hashes = unicode_property_values_hashes;
+        uv_mutex_unlock(&property_hash_count_mutex);
+    }
+    return hashes;
 }
 
 MVMint32 MVM_unicode_name_to_property_value_code(MVMThreadContext *tc, MVMint64 property_code, MVMString *name) {
@@ -411,21 +434,40 @@ MVMint32 MVM_unicode_name_to_property_value_code(MVMThreadContext *tc, MVMint64
         char *cname = MVM_string_ascii_encode(tc, name, &size, 0);
         MVMUnicodeNameRegistry *result;
 
-        HASH_FIND(hash_handle, unicode_property_values_hashes[property_code], cname, strlen((const char *)cname), result);
+        HASH_FIND(hash_handle, get_property_values_hashes(tc)[property_code], cname, strlen((const char *)cname), result);
         MVM_free(cname); /* not really codepoint, really just an index */
         return result ? result->codepoint : 0;
     }
 }
 
+/* Finds a General_Category value by its short name in the generated enum
+ * names, whose index is the value's code. This is what the lookups made at
+ * startup (see MVM_string_cclass_init) need, so they needn't build the
+ * hashes. Returns -1 if the name is not there. */
+static MVMint32 search_general_category_enums(const char *cname, size_t cname_length) {
+    MVMint32 index;
+    for (index = 0; index < (MVMint32)(sizeof(General_Category_enums) / sizeof(char *)); index++) {
+        const char *name = General_Category_enums[index];
+        if (strncmp(name, cname, cname_length) == 0 && name[cname_length] == '\0')
+            return index;
+    }
+    return -1;
+}
+
 MVMint32 MVM_unicode_cname_to_property_value_code(MVMThreadContext *tc, MVMint64 property_code, const char *cname, size_t cname_length) {
     if (property_code <= 0 || property_code >= MVM_NUM_PROPERTY_CODES) {
         return 0;
     }
     else {
-        MVMuint64 size;
         MVMUnicodeNameRegistry *result;
 
-        HASH_FIND(hash_handle, unicode_property_values_hashes[property_code], cname, cname_length, result);
+        if (property_code == MVM_UNICODE_PROPERTY_GENERAL_CATEGORY) {
+            MVMint32 code = search_general_category_enums(cname, cname_length);
+            if (code >= 0)
+                return code;
+        }
+
+        HASH_FIND(hash_handle, get_property_values_hashes(tc)[property_code], cname, cname_length, result);
         return result ? result->codepoint : 0;
     }
 }
@@ -447,23 +489,11 @@ MVMCodepoint MVM_unicode_find_primary_composite(MVMThreadContext *tc, MVMCodepoi
     return 0;
 }
 
-static uv_mutex_t property_hash_count_mutex;
-static int property_hash_count = 0;
-static uv_once_t property_hash_count_guard = UV_ONCE_INIT;
-
-static void setup_property_mutex(void)
-{
-    uv_mutex_init(&property_hash_count_mutex);
-}
-
 void MVM_unicode_init(MVMThreadContext *tc)
 {
     uv_once(&property_hash_count_guard, setup_property_mutex);
 
     uv_mutex_lock(&property_hash_count_mutex);
-    if (property_hash_count == 0) {
-        generate_unicode_property_values_hashes(tc);
-    }
     property_hash_count++;
     uv_mutex_unlock(&property_hash_count_mutex);
 }
@@ -472,7 +502,7 @@ void MVM_unicode_release(MVMThreadContext *tc)
 {
     uv_mutex_lock(&property_hash_count_mutex);
     property_hash_count--;
-    if (property_hash_count == 0) {
+    if (property_hash_count == 0 && unicode_property_values_hashes) {
         int i;
 
         for (i = 0; i < MVM_NUM_PROPERTY_CODES; i++) {
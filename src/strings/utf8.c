@@ -168,6 +168,32 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
 
 #define UTF8_MAXINC (32 * 1024 * 1024)
 
+/* Byte masks for testing a machine word's worth of bytes at once. */
+#define UTF8_WORD_ONES  ((MVMuint64)-1 / 0xFF)
+#define UTF8_WORD_HIGHS (UTF8_WORD_ONES * 0x80)
+#define UTF8_WORD_CRS   (UTF8_WORD_ONES * 0x0D)
+
+/* Counts how many bytes from the start of the input are plain ASCII, which
+ * is anything below 0x80 besides \r (which forms a grapheme with a following
+ * \n). Each of these is a grapheme by itself, with the exception of the last
+ * one, which a combining character after it may attach to. So we can skip
+ * both the decoder and the normalizer for all but the last of a run of them.
+ * Looks at 8 bytes at a time while it can. */
+static size_t plain_ascii_run(const MVMuint8 *utf8, size_t bytes) {
+    size_t i = 0;
+    while (i + sizeof(MVMuint64) <= bytes) {
+        MVMuint64 word, cr;
+        memcpy(&word, utf8 + i, sizeof(MVMuint64));
+        cr = word ^ UTF8_WORD_CRS;
+        if ((word | ((cr - UTF8_WORD_ONES) & ~cr)) & UTF8_WORD_HIGHS)
+            break;
+        i += sizeof(MVMuint64);
+    }
+    while (i < bytes && utf8[i] < 0x80 && utf8[i] != '\r')
+        i++;
+    return i;
+}
+
 /* Decodes the specified number of bytes of utf8 into an NFG string, creating
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
@@ -179,7 +205,7 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     MVMint32 bufsize = bytes;
     MVMGrapheme32 lowest_graph  =  0x7fffffff;
     MVMGrapheme32 highest_graph = -0x7fffffff;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMGrapheme32 *buffer;
     size_t orig_bytes;
     const char *orig_utf8;
     MVMint32 line;
@@ -188,11 +214,36 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
 
     /* Need to normalize to NFG as we decode. */
     MVMNormalizer norm;
+
+    /* Most input is entirely plain ASCII, and needs neither decoding nor
+     * normalizing; we just copy it. */
+    size_t plain = plain_ascii_run((const MVMuint8 *)utf8, bytes);
+    if (plain == bytes) {
+        MVMGrapheme8 *blob = MVM_malloc(bytes ? bytes : 1);
+        memcpy(blob, utf8, bytes);
+        result->body.storage.blob_8 = blob;
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.num_graphs     = bytes;
+        return result;
+    }
+
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
     orig_bytes = bytes;
     orig_utf8 = utf8;
 
+    /* Otherwise, copy all but the last byte of any plain ASCII at the start,
+     * and decode the rest. */
+    if (plain > 1) {
+        for (count = 0; count < (MVMint32)plain - 1; count++)
+            buffer[count] = (MVMuint8)utf8[count];
+        lowest_graph  = 0;
+        highest_graph = 0x7F;
+        utf8  += count;
+        bytes -= count;
+    }
+
     for (; bytes; ++utf8, --bytes) {
         switch(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8)) {
         case UTF8_ACCEPT: { /* got a codepoint */
@@ -214,6 +265,35 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
                     buffer[count++] = g;
                 }
             }
+
+            /* If this was plain ASCII and more follows, there's a grapheme
+             * boundary between them, so we can flush the normalizer and copy
+             * all but the last of the run. */
+            if (codepoint < 0x80 && codepoint != '\r' && bytes > 2
+                    && (MVMuint8)utf8[1] < 0x80) {
+                plain = plain_ascii_run((const MVMuint8 *)utf8 + 1, bytes - 1);
+                if (plain > 1) {
+                    MVM_unicode_normalizer_eof(tc, &norm);
+                    ready = MVM_unicode_normalizer_available(tc, &norm);
+                    while (count + ready + plain >= bufsize) {
+                        buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
+                            bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
+                        ));
+                    }
+                    while (ready--) {
+                        g = MVM_unicode_normalizer_get_grapheme(tc, &norm);
+                        lowest_graph = g < lowest_graph ? g : lowest_graph;
+                        highest_graph = g > highest_graph ? g : highest_graph;
+                        buffer[count++] = g;
+                    }
+                    for (ready = 1; ready < (MVMint32)plain; ready++)
+                        buffer[count++] = (MVMuint8)utf8[ready];
+                    lowest_graph = 0 < lowest_graph ? 0 : lowest_graph;
+                    highest_graph = 0x7F > highest_graph ? 0x7F : highest_graph;
+                    utf8  += plain - 1;
+                    bytes -= plain - 1;
+                }
+            }
             break;
         }
         case UTF8_REJECT:
@@ -400,6 +480,37 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                /* Plain ASCII needs neither decoding nor normalizing, so we
+                 * take a run of it in one go, with the last of it becoming
+                 * the lagging codepoint. */
+                if (state == UTF8_ACCEPT && (MVMuint8)bytes[pos] < 0x80) {
+                    MVMint32 plain = plain_ascii_run((MVMuint8 *)bytes + pos,
+                        cur_bytes->length - pos);
+                    if (plain > 1) {
+                        MVMint32 plain_end = pos + plain;
+                        while (pos < plain_end) {
+                            if (count == bufsize) {
+                                MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                                count = 0;
+                            }
+                            buffer[count++] = lag_codepoint;
+                            total++;
+                            if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                    stopper_chars && *stopper_chars == total) {
+                                reached_stopper = 1;
+                                last_accept_bytes = lag_last_accept_bytes;
+                                last_accept_pos = lag_last_accept_pos;
+                                goto done;
+                            }
+                            lag_codepoint = (MVMuint8)bytes[pos++];
+                            lag_last_accept_bytes = cur_bytes;
+                            lag_last_accept_pos = pos;
+                        }
+                        continue;
+                    }
+                }
+
                 switch(decode_utf8_byte(&state, &codepoint, bytes[pos++])) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -515,65 +626,190 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
     return reached_stopper;
 }
 
+/* Encode state for the UTF-8 encoder. */
+typedef struct {
+    /* The buffer we're encoding into, how much of it we've used, and how
+     * much of it we can use. */
+    MVMuint8 *result;
+    size_t    result_pos;
+    size_t    result_limit;
+
+    /* The replacement for codepoints we can't encode, already encoded, if
+     * we have one. */
+    MVMuint8 *repl_bytes;
+    MVMuint64 repl_length;
+
+    /* If we should translate newline \n into \r\n. */
+    MVMint32 translate_newlines;
+} EncodeState;
+
+/* Makes sure there's space for the specified number of bytes more in the
+ * result buffer. */
+MVM_STATIC_INLINE void ensure_space(EncodeState *state, size_t needed) {
+    if (needed > state->result_limit - state->result_pos) {
+        state->result_limit = 2 * state->result_limit + needed;
+        state->result = MVM_realloc(state->result, state->result_limit);
+    }
+}
+
+/* Encodes a single codepoint, or the replacement if it can't be encoded. */
+static void encode_codepoint(MVMThreadContext *tc, EncodeState *state, MVMCodepoint cp) {
+    MVMint32 bytes;
+    ensure_space(state, 4);
+    bytes = utf8_encode(state->result + state->result_pos, cp);
+    if (bytes) {
+        state->result_pos += bytes;
+    }
+    else if (state->repl_bytes) {
+        ensure_space(state, state->repl_length);
+        memcpy(state->result + state->result_pos, state->repl_bytes, state->repl_length);
+        state->result_pos += state->repl_length;
+    }
+    else {
+        MVM_free(state->result);
+        MVM_free(state->repl_bytes);
+        MVM_string_utf8_throw_encoding_exception(tc, cp);
+    }
+}
+
+/* Encodes a single grapheme, which may be a synthetic. */
+static void encode_grapheme(MVMThreadContext *tc, EncodeState *state, MVMGrapheme32 g) {
+    if (g >= 0) {
+        if (state->translate_newlines && g == '\n')
+            encode_codepoint(tc, state, '\r');
+        encode_codepoint(tc, state, g);
+    }
+    else {
+        MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+        MVMint32 i;
+        encode_codepoint(tc, state, synth->base);
+        for (i = 0; i < synth->num_combs; i++)
+            encode_codepoint(tc, state, synth->combs[i]);
+    }
+}
+
+/* Encodes the graphemes from start up to end of a flat string. ASCII comes
+ * out of UTF-8 encoding unchanged, so we copy runs of it directly out of
+ * 8-bit storage, and take it a grapheme at a time without further ado out of
+ * 32-bit storage. */
+static void encode_flat(MVMThreadContext *tc, EncodeState *state, MVMString *str,
+                        MVMStringIndex start, MVMStringIndex end) {
+    switch (str->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            const MVMGrapheme8 *graphs = str->body.storage.blob_8;
+            while (start < end) {
+                size_t run = state->translate_newlines
+                    ? 0
+                    : plain_ascii_run((const MVMuint8 *)graphs + start, end - start);
+                if (run) {
+                    ensure_space(state, run);
+                    memcpy(state->result + state->result_pos, graphs + start, run);
+                    state->result_pos += run;
+                    start += run;
+                }
+                if (start < end)
+                    encode_grapheme(tc, state, graphs[start++]);
+            }
+            break;
+        }
+        case MVM_STRING_GRAPHEME_32: {
+            const MVMGrapheme32 *graphs = str->body.storage.blob_32;
+            for (; start < end; start++) {
+                MVMGrapheme32 g = graphs[start];
+                if (g >= 0 && g < 0x80 && !(g == '\n' && state->translate_newlines)) {
+                    if (state->result_pos == state->result_limit)
+                        ensure_space(state, 1);
+                    state->result[state->result_pos++] = (MVMuint8)g;
+                }
+                else {
+                    encode_grapheme(tc, state, g);
+                }
+            }
+            break;
+        }
+        default:
+            MVM_exception_throw_adhoc(tc, "Unknown string storage type in UTF-8 encode");
+    }
+}
+
 /* Encodes the specified string to UTF-8. */
 char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
         MVMString *str, MVMuint64 *output_size, MVMint64 start, MVMint64 length,
         MVMString *replacement, MVMint32 translate_newlines) {
-    MVMuint8        *result;
-    size_t           result_pos, result_limit;
-    MVMCodepointIter ci;
-    MVMStringIndex   strgraphs = MVM_string_graphs(tc, str);
-    MVMuint8        *repl_bytes = NULL;
-    MVMuint64        repl_length;
+    EncodeState     state;
+    MVMStringIndex  strgraphs = MVM_string_graphs(tc, str);
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start out of range");
     if (length == -1)
-        length = strgraphs;
+        length = strgraphs - start;
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
+    state.repl_bytes = NULL;
+    state.repl_length = 0;
     if (replacement)
-        repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
-            replacement, &repl_length, 0, -1, NULL, translate_newlines);
-
-    /* Guesstimate that we'll be within 2 bytes for most chars most of the
-     * time, and give ourselves 4 bytes breathing space. */
-    result_limit = 2 * length;
-    result       = MVM_malloc(result_limit + 4);
-    result_pos   = 0;
-
-    /* Iterate the codepoints and encode them. */
-    MVM_string_ci_init(tc, &ci, str, translate_newlines);
-    while (MVM_string_ci_has_more(tc, &ci)) {
-        MVMint32 bytes;
-        MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
-        if (result_pos >= result_limit) {
-            result_limit *= 2;
-            result = MVM_realloc(result, result_limit + 4);
-        }
-        bytes = utf8_encode(result + result_pos, cp);
-        if (bytes)
-            result_pos += bytes;
-        else if (replacement) {
-            if (repl_length >= result_limit || result_pos >= result_limit - repl_length) {
-                result_limit += repl_length;
-                result = MVM_realloc(result, result_limit + 4);
+        state.repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
+            replacement, &state.repl_length, 0, -1, NULL, translate_newlines);
+#ifdef _WIN32
+    state.translate_newlines = translate_newlines;
+#else
+    state.translate_newlines = 0;
+#endif
+
+    /* Size the result up front: 8-bit strings usually come out at a byte
+     * per grapheme, and we guess that we'll be within 2 bytes for most
+     * chars in 32-bit strings. */
+    state.result_limit = length;
+    if (str->body.storage_type == MVM_STRING_STRAND) {
+        MVMuint16 i;
+        for (i = 0; i < str->body.num_strands; i++) {
+            if (str->body.storage.strands[i].blob_string->body.storage_type == MVM_STRING_GRAPHEME_32) {
+                state.result_limit = 2 * length;
+                break;
             }
-            memcpy(result + result_pos, repl_bytes, repl_length);
-            result_pos += repl_length;
         }
-        else {
-            MVM_free(result);
-            MVM_free(repl_bytes);
-            MVM_string_utf8_throw_encoding_exception(tc, cp);
+    }
+    else if (str->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        state.result_limit = 2 * length;
+    }
+    state.result     = MVM_malloc(state.result_limit + 4);
+    state.result_pos = 0;
+
+    /* Encode each strand (and repetition of it) that falls within the range
+     * we were asked for a chunk at a time. */
+    if (str->body.storage_type == MVM_STRING_STRAND) {
+        MVMStringStrand *strands = str->body.storage.strands;
+        MVMStringIndex   skip    = (MVMStringIndex)start;
+        MVMStringIndex   left    = (MVMStringIndex)length;
+        MVMuint16 i;
+        for (i = 0; i < str->body.num_strands && left; i++) {
+            MVMStringStrand *strand     = &(strands[i]);
+            MVMStringIndex   strand_len = strand->end - strand->start;
+            MVMuint32        rep;
+            for (rep = 0; rep <= strand->repetitions && left; rep++) {
+                MVMStringIndex chunk;
+                if (skip >= strand_len) {
+                    skip -= strand_len;
+                    continue;
+                }
+                chunk = strand_len - skip < left ? strand_len - skip : left;
+                encode_flat(tc, &state, strand->blob_string, strand->start + skip,
+                    strand->start + skip + chunk);
+                left -= chunk;
+                skip  = 0;
+            }
         }
     }
+    else {
+        encode_flat(tc, &state, str, (MVMStringIndex)start, (MVMStringIndex)(start + length));
+    }
 
     if (output_size)
-        *output_size = (MVMuint64)result_pos;
-    MVM_free(repl_bytes);
-    return (char *)result;
+        *output_size = (MVMuint64)state.result_pos;
+    MVM_free(state.repl_bytes);
+    return (char *)state.result;
 }
 
 /* Encodes the specified string to UTF-8. */
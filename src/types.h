@@ -34,9 +34,13 @@ typedef struct MVMContextBody MVMContextBody;
 typedef struct MVMContinuationTag MVMContinuationTag;
 typedef struct MVMDecoder MVMDecoder;
 typedef struct MVMDecoderBody MVMDecoderBody;
+typedef struct MVMStringBuilder MVMStringBuilder;
+typedef struct MVMStringBuilderBody MVMStringBuilderBody;
 typedef struct MVMDLLRegistry MVMDLLRegistry;
 typedef struct MVMDLLSym MVMDLLSym;
 typedef struct MVMDLLSymBody MVMDLLSymBody;
+typedef struct MVMDynlexCache MVMDynlexCache;
+typedef struct MVMDynlexCacheEntry MVMDynlexCacheEntry;
 typedef struct MVMException MVMException;
 typedef struct MVMExceptionBody MVMExceptionBody;
 typedef struct MVMExtOpRecord MVMExtOpRecord;
@@ -60,8 +64,8 @@ typedef struct MVMHash MVMHash;
 typedef struct MVMHashAttrStore MVMHashAttrStore;
 typedef struct MVMHashAttrStoreBody MVMHashAttrStoreBody;
 typedef struct MVMHashBody MVMHashBody;
-typedef struct MVMHashEntry MVMHashEntry;
 typedef struct MVMHLLConfig MVMHLLConfig;
+typedef struct MVMInlineCache MVMInlineCache;
 typedef struct MVMIntConstCache MVMIntConstCache;
 typedef struct MVMInstance MVMInstance;
 typedef struct MVMInvocationSpec MVMInvocationSpec;
@@ -72,6 +76,7 @@ typedef struct MVMKnowHOWAttributeREPRBody MVMKnowHOWAttributeREPRBody;
 typedef struct MVMKnowHOWREPR MVMKnowHOWREPR;
 typedef struct MVMKnowHOWREPRBody MVMKnowHOWREPRBody;
 typedef struct MVMLexicalRegistry MVMLexicalRegistry;
+typedef struct MVMLexicalLookupCacheEntry MVMLexicalLookupCacheEntry;
 typedef struct MVMLexotic MVMLexotic;
 typedef struct MVMLexoticBody MVMLexoticBody;
 typedef struct MVMLoadedCompUnitName MVMLoadedCompUnitName;
@@ -109,6 +114,7 @@ typedef struct MVMCUnion MVMCUnion;
 typedef struct MVMCUnionBody MVMCUnionBody;
 typedef struct MVMCUnionNameMap MVMCUnionNameMap;
 typedef struct MVMCUnionREPRData MVMCUnionREPRData;
+typedef struct MVMMethodInlineCacheEntry MVMMethodInlineCacheEntry;
 typedef struct MVMMultiCache MVMMultiCache;
 typedef struct MVMMultiCacheBody MVMMultiCacheBody;
 typedef struct MVMMultiCacheNode MVMMultiCacheNode;
@@ -125,8 +131,16 @@ typedef struct MVMSemaphore MVMSemaphore;
 typedef struct MVMSemaphoreBody MVMSemaphoreBody;
 typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
-typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
+typedef struct MVMConcBlockingQueueSegment MVMConcBlockingQueueSegment;
 typedef struct MVMConcBlockingQueueLocks MVMConcBlockingQueueLocks;
+typedef struct MVMConcHash MVMConcHash;
+typedef struct MVMConcHashBody MVMConcHashBody;
+typedef struct MVMConcHashStripe MVMConcHashStripe;
+typedef struct MVMConcScheduler MVMConcScheduler;
+typedef struct MVMConcSchedulerBody MVMConcSchedulerBody;
+typedef struct MVMConcSchedulerBuffer MVMConcSchedulerBuffer;
+typedef struct MVMConcSchedulerDeque MVMConcSchedulerDeque;
+typedef struct MVMConcSchedulerPool MVMConcSchedulerPool;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -180,6 +194,9 @@ typedef struct MVMStaticFrame MVMStaticFrame;
 typedef struct MVMStaticFrameBody MVMStaticFrameBody;
 typedef struct MVMStaticFrameInstrumentation MVMStaticFrameInstrumentation;
 typedef struct MVMStorageSpec MVMStorageSpec;
+typedef struct MVMStrHashEntry MVMStrHashEntry;
+typedef struct MVMStrHashSlot MVMStrHashSlot;
+typedef struct MVMStrHashTable MVMStrHashTable;
 typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
 typedef struct MVMStringConsts MVMStringConsts;
@@ -241,3 +258,6 @@ typedef struct MVMHeapSnapshotReference MVMHeapSnapshotReference;
 typedef struct MVMHeapSnapshotState MVMHeapSnapshotState;
 typedef struct MVMHeapSnapshotWorkItem MVMHeapSnapshotWorkItem;
 typedef struct MVMHeapSnapshotSeen MVMHeapSnapshotSeen;
+typedef struct MVMOpProfile MVMOpProfile;
+typedef struct MVMOpProfileFrame MVMOpProfileFrame;
+typedef struct MVMOpProfileCursor MVMOpProfileCursor;
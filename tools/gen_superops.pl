@@ -0,0 +1,234 @@
+#!/usr/bin/env perl
+use v5.14;
+use warnings; use strict;
+# Generates superinstructions: ops that run the bodies of a pair of ops that
+# commonly execute one after the other, saving a dispatch. The pairs are
+# picked from op profiles written by a MoarVM built with "make opprofile"
+# and run with MVM_OP_PROFILE_LOG=<file> and MVM_OP_PROFILE_PAIRS=1.
+#
+#   perl tools/gen_superops.pl [--count=N] profile-file...
+#
+# This appends the superinstructions to the end of src/core/oplist (replacing
+# any that were generated before), and writes src/core/superops.h and
+# src/core/superops_interp.h. Afterwards, run tools/update_ops.p6 to update
+# the op tables.
+#
+# A superinstruction takes the operands of its first op; the second op stays
+# in the bytecode right after them, just as it would be without fusion. The
+# first op's body runs, and if it left cur_op at the second op (so it did not
+# branch, invoke, throw or return), we carry on into the second op's body;
+# otherwise we dispatch as usual. That means the specializer can use one in
+# place of any op pair in the same basic block without changing anything
+# else about the bytecode.
+
+my $OPLIST   = 'src/core/oplist';
+my $INTERP   = 'src/core/interp.c';
+my $HEADER   = 'src/core/superops.h';
+my $BODIES   = 'src/core/superops_interp.h';
+my $MARKER   = '# Superinstructions, generated by tools/gen_superops.pl; do not edit by hand.';
+my $FUSED    = 'sp_fuse_';
+
+my $count = 16;
+my @profiles;
+for my $arg (@ARGV) {
+    if ($arg =~ /^--count=(\d+)$/) {
+        $count = $1;
+    }
+    else {
+        push @profiles, $arg;
+    }
+}
+die "Usage: $0 [--count=N] profile-file...\n" unless @profiles;
+
+# Sizes of literal operands in the bytecode; registers are 2 bytes and
+# lexicals 4.
+my %literal_size = (
+    int8 => 1, uint8 => 1, int16 => 2, uint16 => 2, int32 => 4, uint32 => 4,
+    int64 => 8, uint64 => 8, num32 => 4, num64 => 8, str => 4, ins => 4,
+    coderef => 2, callsite => 2, sslot => 2,
+);
+
+# Read the op list, leaving out anything we generated before.
+my (@oplist_lines, %op_operands, %op_size);
+open my $ol, '<', $OPLIST or die "Cannot open $OPLIST: $!";
+while (my $line = <$ol>) {
+    last if $line =~ /^\Q$MARKER\E/;
+    push @oplist_lines, $line;
+    next if $line =~ /^\s*(#|$)/;
+    my ($name, @parts) = split ' ', $line;
+    my (@operands, $size);
+    $size = 2;
+    for my $part (@parts) {
+        next if $part =~ /^[.:+*-]/;
+        push @operands, $part;
+        if ($part =~ /^[rw]l\(/) {
+            $size += 4;
+        }
+        elsif ($part =~ /^[rw]\(/) {
+            $size += 2;
+        }
+        elsif (exists $literal_size{$part}) {
+            $size += $literal_size{$part};
+        }
+        else {
+            die "Unknown operand '$part' for op $name";
+        }
+    }
+    $op_operands{$name} = \@operands;
+    $op_size{$name}     = $size;
+}
+close $ol;
+pop @oplist_lines while @oplist_lines && $oplist_lines[-1] =~ /^\s*$/;
+
+# Pull the op bodies out of the interpreter.
+my %op_body;
+{
+    open my $in, '<', $INTERP or die "Cannot open $INTERP: $!";
+    my ($cur, @body);
+    my $finish = sub {
+        $op_body{$cur} = join '', @body if defined $cur;
+        ($cur, @body) = ();
+    };
+    while (my $line = <$in>) {
+        if ($line =~ /^ {12}OP\((\w+)\):(.*)$/s) {
+            my ($name, $rest) = ($1, $2);
+            $finish->();
+            $cur  = $name;
+            @body = $rest =~ /\S/ ? ($rest =~ s/^\s+/                /r) : ();
+        }
+        elsif ($line =~ /^#include "superops_interp\.h"/ || $line =~ /^#if MVM_CGOTO$/) {
+            $finish->();
+        }
+        elsif (defined $cur) {
+            push @body, $line;
+        }
+    }
+    $finish->();
+    close $in;
+}
+
+# Bodies that are blocks get indented another level, since they will end up
+# inside the block of the superinstruction.
+for my $body (values %op_body) {
+    next unless $body =~ /^\s*\{/;
+    $body =~ s/(?<=\n)(?=.)/    /g;
+}
+
+# Bodies must be self-contained (not fall through into the next op), and may
+# not define goto labels, since we'll be duplicating them.
+sub usable_body {
+    my ($name) = @_;
+    my $body = $op_body{$name};
+    return 0 unless defined $body && $body =~ /\S/;
+    return 0 unless $body =~ /goto NEXT;/;
+    for my $line (split /\n/, $body) {
+        return 0 if $line =~ /^\s*(?!default\b)([A-Za-z_]\w*)\s*:(?!:)/ && $line !~ /^\s*case\b/;
+    }
+    return 1;
+}
+
+# Sum up the pair counts from all the profiles.
+my %pair_count;
+for my $file (@profiles) {
+    open my $fh, '<', $file or die "Cannot open $file: $!";
+    while (<$fh>) {
+        # Superinstructions are only used in specialized code.
+        next unless /^pair spesh (\w+) (\w+) (\d+)$/;
+        $pair_count{"$1 $2"} += $3;
+    }
+    close $fh;
+}
+
+# Pick the most common pairs that we can fuse.
+my @chosen;
+for my $pair (sort { $pair_count{$b} <=> $pair_count{$a} || $a cmp $b } keys %pair_count) {
+    last if @chosen >= $count;
+    my ($first, $second) = split ' ', $pair;
+    next if $first =~ /^\Q$FUSED\E/ || $second =~ /^\Q$FUSED\E/;
+    next unless exists $op_size{$first} && exists $op_size{$second};
+    next unless usable_body($first) && usable_body($second);
+    next if grep { $_ eq 'ins' } @{$op_operands{$first}}; # branches end basic blocks
+    push @chosen, [$first, $second];
+}
+say "Chose " . scalar(@chosen) . " superinstructions";
+
+sub fused_name { "$FUSED$_[0][0]_$_[0][1]" }
+
+# Update the op list.
+open my $olo, '>', $OPLIST or die "Cannot write $OPLIST: $!";
+print $olo @oplist_lines;
+if (@chosen) {
+    print $olo "\n$MARKER\n";
+    print $olo "# Each runs its first op and, if that falls through, the op after it. See\n";
+    print $olo "# the tool for details.\n";
+    for my $pair (@chosen) {
+        my $name = fused_name($pair);
+        print $olo sprintf("%-40s .s %s\n", $name, join ' ', @{$op_operands{$pair->[0]}}) =~ s/ +\n/\n/r;
+    }
+}
+close $olo;
+
+# Write the header used by spesh to fuse and unfuse op pairs.
+open my $h, '>', $HEADER or die "Cannot write $HEADER: $!";
+print $h <<'END';
+/* This file is generated by tools/gen_superops.pl; do not edit by hand. */
+
+/* Gets the superinstruction that fuses the two ops, or zero if there is
+ * none. */
+MVM_STATIC_INLINE MVMuint16 MVM_superop_for(MVMuint16 first, MVMuint16 second) {
+    switch (first) {
+END
+my %by_first;
+push @{$by_first{$_->[0]}}, $_ for @chosen;
+for my $first (sort keys %by_first) {
+    print $h "        case MVM_OP_$first:\n";
+    print $h "            switch (second) {\n";
+    for my $pair (@{$by_first{$first}}) {
+        print $h "                case MVM_OP_$pair->[1]: return MVM_OP_" . fused_name($pair) . ";\n";
+    }
+    print $h "            }\n";
+    print $h "            break;\n";
+}
+print $h <<'END';
+    }
+    return 0;
+}
+
+/* Maps a superinstruction back to the first op it fuses; other ops are
+ * returned unchanged. */
+MVM_STATIC_INLINE MVMuint16 MVM_superop_unfuse(MVMuint16 op) {
+    switch (op) {
+END
+for my $pair (@chosen) {
+    print $h "        case MVM_OP_" . fused_name($pair) . ": return MVM_OP_$pair->[0];\n";
+}
+print $h <<'END';
+        default: return op;
+    }
+}
+END
+close $h;
+
+# Write the interpreter bodies.
+open my $b, '>', $BODIES or die "Cannot write $BODIES: $!";
+print $b "/* This file is generated by tools/gen_superops.pl from the op bodies in\n";
+print $b " * interp.c; do not edit by hand. It is included in the interpreter's\n";
+print $b " * dispatch. */\n";
+for my $pair (@chosen) {
+    my $name  = fused_name($pair);
+    my $label = "${name}_second";
+    my $first = $op_body{$pair->[0]};
+    $first =~ s/goto NEXT;/goto $label;/g;
+    print $b "            OP($name): {\n";
+    print $b "                MVMuint8 *fuse_next = cur_op + " . ($op_size{$pair->[0]} - 2) . ";\n";
+    print $b $first;
+    print $b "              $label:\n";
+    print $b "                if (cur_op != fuse_next)\n";
+    print $b "                    goto NEXT;\n";
+    print $b "                cur_op += 2;\n";
+    print $b $op_body{$pair->[1]};
+    print $b "            }\n";
+}
+close $b;
+
+say "Now run tools/update_ops.p6 to update the op tables.";
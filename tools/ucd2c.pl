@@ -17,6 +17,7 @@ $Data::Dumper::Maxdepth = 1;
 my $DEBUG = $ENV{UCD2CDEBUG} // 0;
 
 my @name_lines;
+my @row_bitfield_indexes;
 if $DEBUG {
     open(LOG, ">extents") or die "can't create extents: $!";
     binmode LOG, ':encoding(UTF-8)';
@@ -499,7 +500,6 @@ sub add_extent($$) {
 }
 
 sub emit_codepoints_and_planes {
-    my @bitfield_index_lines;
     my $index = 0;
     my $bytes = 0;
     my $bytes_saved = 0;
@@ -552,9 +552,7 @@ sub emit_codepoints_and_planes {
                 while ($span_length > 1) {
                     # catch up to last code
                     $last_point = $last_point->{next_point};
-                    push @bitfield_index_lines,
-                        "/*$index*/$last_point->{bitfield_index}/*".
-                        "$last_point->{code_str} */";
+                    push @row_bitfield_indexes, $last_point->{bitfield_index};
                     push @name_lines, "/*$index*/".
                     ($last_point->{name} =~ /^</ && $usually++ % 25 ? "NULL" : "\"$last_point->{name}\"").
                         "/* $last_point->{code_str} */";
@@ -579,7 +577,7 @@ sub emit_codepoints_and_planes {
             }
 
             while ($last_code < $point->{code} - 1) {
-                push @bitfield_index_lines, "0";
+                push @row_bitfield_indexes, 0;
                 push @name_lines, "NULL";
                 $last_code++;
                 $index++;
@@ -595,7 +593,7 @@ sub emit_codepoints_and_planes {
             }
             $toadd = undef;
             # a normal codepoint that we don't want to compress
-            push @bitfield_index_lines, "/*$index*/$point->{bitfield_index}/* $point->{code_str} */";
+            push @row_bitfield_indexes, $point->{bitfield_index};
             $bytes += 2; # hopefully these are compacted since they are trivially aligned being two bytes
             push @name_lines, "/*$index*/\"$point->{name}\"/* $point->{code_str} */";
             $bytes += length($point->{name}) + 9; # 8 for the pointer, 1 for the NUL
@@ -612,10 +610,6 @@ sub emit_codepoints_and_planes {
         "static const char *codepoint_names[$index] = {\n    ".
             stack_lines(\@name_lines, ",", ",\n    ", 0, $wrap_to_columns).
             "\n};";
-    $db_sections->{BBB_codepoint_bitfield_indexes} =
-        "static const MVMuint16 codepoint_bitfield_indexes[$index] = {\n    ".
-            stack_lines(\@bitfield_index_lines, ",", ",\n    ", 0, $wrap_to_columns).
-            "\n};";
     $h_sections->{codepoint_names_count} = "#define MVM_CODEPOINT_NAMES_COUNT $index";
     $extents
 }
@@ -625,35 +619,160 @@ sub emit_codepoint_row_lookup {
     my $SMP_start;
     my $i = 0;
     for (@$extents) {
-        # handle the first recursion specially to optimize for most common BMP lookups
+        # the planes beyond the BMP are looked up in the extents from here
         if ($_->{code} >= 0x10000) {
             $SMP_start = $i;
             last;
         }
         $i++;
     }
-    my $out = "static MVMint32 MVM_codepoint_to_row_index(MVMThreadContext *tc, MVMint32 codepoint) {\n
-    MVMint32 plane = codepoint >> 16;
 
-    if (codepoint < 0) {
-        MVM_exception_throw_adhoc(tc, \"Error, MoarVM cannot get Unicode codepoint property for synthetic codepoint %i", codepoint);
+    # Work out the row of every codepoint; each extent covers codepoints up
+    # to the start of the next one.
+    my @rows;
+    my $e = 0;
+    for my $cp (0 .. 0x10FFFF) {
+        $e++ while $e < $#$extents && $extents->[$e + 1]->{code} <= $cp;
+        $e = $SMP_start if $cp >= 0x10000 && $e < $SMP_start;
+        my $fate = $extents->[$e];
+        push @rows, $cp > 0x10FFFD || $fate->{fate_type} == $FATE_NULL
+            ? -1
+            : $fate->{fate_type} == $FATE_SPAN
+                ? $fate->{code} - $fate->{fate_offset}
+                : $cp - $fate->{fate_offset};
     }
 
-    if (plane == 0) {"
-    .emit_binary_search_algorithm($extents, 0, 1, $SMP_start - 1, "        ")."
-    }
-    else {
-        if (plane < 0 || plane > 16 || codepoint > 0x10FFFD) {
-            return -1;
+    # Split them into blocks of 64. Most blocks are a run of consecutive
+    # rows, so we just store the first; the rest go into a table, sharing
+    # identical blocks. The entries for the blocks are then split into chunks
+    # of 16, again sharing identical ones, which takes care of the large
+    # unassigned areas.
+    my (@blocks, @table_lines, %table_blocks);
+    my $num_table_blocks = 0;
+    for (my $start = 0; $start < 0x110000; $start += 64) {
+        my @block = @rows[$start .. $start + 63];
+        my $consecutive = $block[0] >= 0;
+        for (1 .. 63) {
+            if ($block[$_] != $block[0] + $_) {
+                $consecutive = 0;
+                last;
+            }
+        }
+        if ($consecutive) {
+            push @blocks, $block[0];
+            next;
         }
-        else {".emit_binary_search_algorithm($extents, $SMP_start,
-            int(($SMP_start + scalar(@$extents)-1)/2), scalar(@$extents) - 1, "            ")."
+        my $key = join ',', @block;
+        if (!exists $table_blocks{$key}) {
+            $table_blocks{$key} = $num_table_blocks++;
+            for (@block) {
+                die "codepoint row $_ too big for codepoint_row_table" if $_ >= 0xFFFF;
+                push @table_lines, $_ < 0 ? 0xFFFF : $_;
+            }
         }
+        push @blocks, -1 - $table_blocks{$key};
     }
+    my ($chunk_lines, $block_lines) = share_blocks(\@blocks, 16);
+    my $chunks_size = scalar @$chunk_lines;
+    my $blocks_size = scalar @$block_lines;
+    my $table_size  = scalar @table_lines;
+    $estimated_total_bytes += 2 * $chunks_size + 4 * $blocks_size + 2 * $table_size;
+
+    # The properties lookups go straight from the codepoint to its row in
+    # props_bitfield, through blocks of 32 codepoints shared between all
+    # that have the same rows, and chunks of 32 of those.
+    my @bitfield_rows = map {
+        my $bitfield_row = $_ < 0 ? 0xFFFF : $row_bitfield_indexes[$_];
+        die "bitfield row $bitfield_row too big for codepoint_bitfield_rows"
+            if $_ >= 0 && $bitfield_row >= 0xFFFF;
+        $bitfield_row
+    } @rows;
+    my ($bitfield_block_lines, $bitfield_row_lines) = share_blocks(\@bitfield_rows, 32);
+    my ($bitfield_chunk_lines, $bitfield_chunked_lines) = share_blocks($bitfield_block_lines, 32);
+    my $bitfield_chunks_size = scalar @$bitfield_chunk_lines;
+    my $bitfield_blocks_size = scalar @$bitfield_chunked_lines;
+    my $bitfield_rows_size   = scalar @$bitfield_row_lines;
+    $estimated_total_bytes += 2 * ($bitfield_chunks_size + $bitfield_blocks_size + $bitfield_rows_size);
+
+    my $out = "/* Maps codepoints to their row in codepoint_names.
+ * codepoint_row_chunks gives, for each 1024 codepoints, where its 16 entries
+ * start in codepoint_row_blocks. Each of those covers 64 codepoints, and is
+ * either the row of the first of them, when the rows run on from it, or -1
+ * minus the block's index in codepoint_row_table, where 0xFFFF means there's
+ * no row. */
+static const MVMuint16 codepoint_row_chunks[$chunks_size] = {\n    ".
+        stack_lines($chunk_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static const MVMint32 codepoint_row_blocks[$blocks_size] = {\n    ".
+        stack_lines($block_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static const MVMuint16 codepoint_row_table[$table_size] = {\n    ".
+        stack_lines(\@table_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static MVMint32 MVM_codepoint_to_row_index(MVMThreadContext *tc, MVMint32 codepoint) {
+    MVMint32  block;
+    MVMuint16 row;
+
+    if (codepoint < 0) {
+        MVM_exception_throw_adhoc(tc, \"Error, MoarVM cannot get Unicode codepoint property for synthetic codepoint %i\", codepoint);
+    }
+    if (codepoint > 0x10FFFF)
+        return -1;
+
+    block = codepoint_row_blocks[(codepoint_row_chunks[codepoint >> 10] << 4) + ((codepoint >> 6) & 0xF)];
+    if (block >= 0)
+        return block + (codepoint & 0x3F);
+    row = codepoint_row_table[((-1 - block) << 6) + (codepoint & 0x3F)];
+    return row == 0xFFFF ? -1 : row;
+}
+
+/* Maps codepoints to their row in props_bitfield, in the same way, except
+ * that blocks are 32 codepoints and always go through the table. */
+static const MVMuint16 codepoint_bitfield_chunks[$bitfield_chunks_size] = {\n    ".
+        stack_lines($bitfield_chunk_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static const MVMuint16 codepoint_bitfield_blocks[$bitfield_blocks_size] = {\n    ".
+        stack_lines($bitfield_chunked_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static const MVMuint16 codepoint_bitfield_rows[$bitfield_rows_size] = {\n    ".
+        stack_lines($bitfield_row_lines, ",", ",\n    ", 0, $wrap_to_columns).
+        "\n};
+static MVMint32 MVM_codepoint_to_bitfield_row(MVMThreadContext *tc, MVMint32 codepoint) {
+    MVMuint16 block;
+    MVMuint16 row;
+
+    if (codepoint < 0) {
+        MVM_exception_throw_adhoc(tc, \"Error, MoarVM cannot get Unicode codepoint property for synthetic codepoint %i\", codepoint);
+    }
+    if (codepoint > 0x10FFFF)
+        return -1;
+
+    block = codepoint_bitfield_blocks[(codepoint_bitfield_chunks[codepoint >> 10] << 5) + ((codepoint >> 5) & 0x1F)];
+    row   = codepoint_bitfield_rows[(block << 5) + (codepoint & 0x1F)];
+    return row == 0xFFFF ? -1 : row;
 }";
     $db_sections->{codepoint_row_lookup} = $out;
 }
 
+# Splits the values into blocks of the given size, sharing identical ones.
+# Returns the index of each block's first value in the shared table, divided
+# by the size, along with the table.
+sub share_blocks {
+    my ($values, $size) = @_;
+    my (@indexes, @table, %seen);
+    my $count = 0;
+    for (my $start = 0; $start < @$values; $start += $size) {
+        my @block = @$values[$start .. $start + $size - 1];
+        my $key = join ',', @block;
+        if (!exists $seen{$key}) {
+            $seen{$key} = $count++;
+            push @table, @block;
+        }
+        push @indexes, $seen{$key};
+    }
+    (\@indexes, \@table)
+}
+
 sub emit_case_changes {
     my $point = shift;
     my @lines = ();
@@ -726,33 +845,27 @@ sub emit_property_value_lookup {
     my $out = "
 static MVMint32 MVM_unicode_get_property_int(MVMThreadContext *tc, MVMint32 codepoint, MVMint64 property_code) {
     MVMuint32 switch_val = (MVMuint32)property_code;
-    MVMuint32 codepoint_row = MVM_codepoint_to_row_index(tc, codepoint);
-    MVMuint16 bitfield_row;
+    MVMint32 bitfield_row = MVM_codepoint_to_bitfield_row(tc, codepoint);
 
-    if (codepoint_row == -1) /* non-existent codepoint; XXX should throw? */
+    if (bitfield_row == -1) /* non-existent codepoint; XXX should throw? */
         return 0;
 
-    bitfield_row = codepoint_bitfield_indexes[codepoint_row];
-
     switch (switch_val) {
         case 0: return 0;";
 
     my $eout = "
-static MVMint32 MVM_codepoint_to_row_index(MVMThreadContext *tc, MVMint32 codepoint);
+static MVMint32 MVM_codepoint_to_bitfield_row(MVMThreadContext *tc, MVMint32 codepoint);
 
 static const char *bogus = \"<BOGUS>\"; /* only for table too short; return null string for no mapping */
 
 static const char* MVM_unicode_get_property_str(MVMThreadContext *tc, MVMint32 codepoint, MVMint64 property_code) {
     MVMuint32 switch_val = (MVMuint32)property_code;
     MVMint32 result_val = 0; /* we'll never have negatives, but so */
-    MVMuint32 codepoint_row = MVM_codepoint_to_row_index(tc, codepoint);
-    MVMuint16 bitfield_row;
+    MVMint32 bitfield_row = MVM_codepoint_to_bitfield_row(tc, codepoint);
 
-    if (codepoint_row == -1) /* non-existent codepoint; XXX should throw? */
+    if (bitfield_row == -1) /* non-existent codepoint; XXX should throw? */
         return \"\";
 
-    bitfield_row = codepoint_bitfield_indexes[codepoint_row];
-
     switch (switch_val) {
         case 0: return \"\";";
 